@@ -0,0 +1,646 @@
+/*
+
+Copyright [2008] [Trevor Hogan]
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+// analyze_replays recomputes the game stats of a directory of replays without a running bot
+// each replay is parsed with CReplay :: ParseReplay and its actions are passed to the same stats classes the bot uses (CStatsDOTA or CStatsW3MMD)
+// the replays are spread over several worker threads and the results are written to tab separated files which can be loaded with LOAD DATA INFILE
+
+/*
+Config file (analyze_replays.cfg by default, or the first argument) ---
+replay_path = ../replays/		the directory to read replays (*.w3g) from
+output_path = ./				the directory to write the results to
+stats = dota					which stats class to use, "dota" or "w3mmd"
+w3mmd_category =				the category to record w3mmd stats under
+firstgameid = 1					the game id of the first replay (replays are numbered in the order of their file names)
+threads = 0						the number of worker threads, 0 to use one per core
+verbose = 0						whether to print the bot's console output while processing replays
+
+Output files ---
+games.txt			gameid, replay file, game name, replay length (ms)
+dotagames.txt		gameid, winner, min, sec
+dotaplayers.txt		gameid, name, colour, kills, deaths, creepkills, creepdenies, assists, gold, neutralkills, item1-6, hero, newcolour, towerkills, raxkills, courierkills, outcome, level, apm
+dotaevents.txt		gameid, type, game name, killer, victim, killer colour, victim colour
+w3mmdplayers.txt	category, gameid, pid, name, flag, leaver, practicing
+w3mmdvars.txt		gameid, pid, varname, int value, real value, string value
+*/
+
+#include "ghost.h"
+#include "util.h"
+#include "config.h"
+#include "ghostdb.h"
+#include "packed.h"
+#include "gameslot.h"
+#include "replay.h"
+#include "gameprotocol.h"
+#include "stats.h"
+#include "statsdota.h"
+#include "statsw3mmd.h"
+
+#include <time.h>
+
+#ifdef WIN32
+ #include <windows.h>
+ #include <mmsystem.h>
+#endif
+
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <boost/filesystem.hpp>
+
+boost::mutex gConsoleMutex;
+bool gVerbose = false;
+uint32_t gLogLevels[LOGCAT_NUMCATEGORIES] = { LOGLEVEL_INFO, LOGLEVEL_INFO, LOGLEVEL_INFO, LOGLEVEL_INFO };
+
+void CONSOLE_Print( string message )
+{
+	LOG_Print( LOGCAT_GENERAL, LOGLEVEL_INFO, message );
+}
+
+void LOG_Write( uint32_t level, string message )
+{
+	if( gVerbose )
+	{
+		boost::mutex :: scoped_lock Lock( gConsoleMutex );
+		cout << message << endl;
+	}
+}
+
+void LOG_WriteFile( string file, string message )
+{
+
+}
+
+void DEBUG_Print( string message )
+{
+	CONSOLE_Print( message );
+}
+
+void DEBUG_Print( BYTEARRAY b )
+{
+
+}
+
+uint32_t GetTime( )
+{
+	return GetTicks( ) / 1000;
+}
+
+uint32_t GetTicks( )
+{
+#ifdef WIN32
+	return timeGetTime( );
+#else
+	uint32_t ticks;
+	struct timespec t;
+	clock_gettime( CLOCK_MONOTONIC, &t );
+	ticks = t.tv_sec * 1000;
+	ticks += t.tv_nsec / 1000000;
+	return ticks;
+#endif
+}
+
+//
+// CReplayOutput
+//
+
+// the output files shared by every worker thread
+// each worker collects rows in memory and appends them here in large chunks so the workers rarely wait for each other
+
+class CReplayOutput
+{
+public:
+	enum File {
+		OUTPUT_GAMES		= 0,
+		OUTPUT_DOTAGAMES	= 1,
+		OUTPUT_DOTAPLAYERS	= 2,
+		OUTPUT_DOTAEVENTS	= 3,
+		OUTPUT_W3MMDPLAYERS	= 4,
+		OUTPUT_W3MMDVARS	= 5,
+		OUTPUT_COUNT		= 6
+	};
+
+private:
+	boost::mutex m_Mutex;
+	ofstream m_Files[OUTPUT_COUNT];
+
+public:
+	bool Open( string path );
+	void Write( string *rows );
+	void Close( );
+};
+
+bool CReplayOutput :: Open( string path )
+{
+	const char *FileNames[OUTPUT_COUNT] = { "games.txt", "dotagames.txt", "dotaplayers.txt", "dotaevents.txt", "w3mmdplayers.txt", "w3mmdvars.txt" };
+
+	for( int i = 0; i < OUTPUT_COUNT; i++ )
+	{
+		string File = path + FileNames[i];
+		m_Files[i].open( File.c_str( ), ios :: binary | ios :: trunc );
+
+		if( m_Files[i].fail( ) )
+		{
+			cout << "error: unable to open [" << File << "] for writing" << endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void CReplayOutput :: Write( string *rows )
+{
+	boost::mutex :: scoped_lock Lock( m_Mutex );
+
+	for( int i = 0; i < OUTPUT_COUNT; i++ )
+	{
+		m_Files[i].write( rows[i].c_str( ), rows[i].size( ) );
+		rows[i].clear( );
+	}
+}
+
+void CReplayOutput :: Close( )
+{
+	for( int i = 0; i < OUTPUT_COUNT; i++ )
+		m_Files[i].close( );
+}
+
+//
+// CReplayDB
+//
+
+// a database which writes the rows the stats classes save to the output files instead of a real database
+// the rows are written immediately so the threaded functions don't return a callable
+
+class CReplayDB : public CGHostDB
+{
+private:
+	CReplayOutput *m_Output;
+	string m_Rows[CReplayOutput :: OUTPUT_COUNT];
+	uint32_t m_GameID;
+
+public:
+	CReplayDB( CConfig *CFG, CReplayOutput *nOutput );
+	virtual ~CReplayDB( );
+
+	void SetGameID( uint32_t nGameID )	{ m_GameID = nGameID; }
+	void AddRow( int file, string row );
+	void Flush( );
+
+	virtual CCallableDotAEventAdd *ThreadedDotAEventAdd( uint32_t gameid, string gamename, string Killer, string Victim, uint32_t kcolour, uint32_t vcolour );
+	virtual CCallableDotAGameAdd *ThreadedDotAGameAdd( uint32_t gameid, uint32_t winner, uint32_t min, uint32_t sec );
+	virtual CCallableDotAPlayerAdd *ThreadedDotAPlayerAdd( uint32_t gameid, string name, uint32_t colour, uint32_t kills, uint32_t deaths, uint32_t creepkills, uint32_t creepdenies, uint32_t assists, uint32_t gold, uint32_t neutralkills, string item1, string item2, string item3, string item4, string item5, string item6, string hero, uint32_t newcolour, uint32_t towerkills, uint32_t raxkills, uint32_t courierkills, uint32_t outcome, uint32_t level, uint32_t apm );
+	virtual CCallableW3MMDPlayerAdd *ThreadedW3MMDPlayerAdd( string category, uint32_t gameid, uint32_t pid, string name, string flag, uint32_t leaver, uint32_t practicing );
+	virtual CCallableW3MMDVarAdd *ThreadedW3MMDVarAdd( uint32_t gameid, map<VarP,int32_t> var_ints );
+	virtual CCallableW3MMDVarAdd *ThreadedW3MMDVarAdd( uint32_t gameid, map<VarP,double> var_reals );
+	virtual CCallableW3MMDVarAdd *ThreadedW3MMDVarAdd( uint32_t gameid, map<VarP,string> var_strings );
+};
+
+string EscapeField( string field )
+{
+	// escape the field the way LOAD DATA INFILE expects by default
+
+	string Result;
+	Result.reserve( field.size( ) );
+
+	for( string :: iterator i = field.begin( ); i != field.end( ); i++ )
+	{
+		if( *i == '\\' )
+			Result += "\\\\";
+		else if( *i == '\t' )
+			Result += "\\t";
+		else if( *i == '\n' )
+			Result += "\\n";
+		else if( *i == 0 )
+			Result += "\\0";
+		else
+			Result += *i;
+	}
+
+	return Result;
+}
+
+CReplayDB :: CReplayDB( CConfig *CFG, CReplayOutput *nOutput ) : CGHostDB( CFG )
+{
+	m_Output = nOutput;
+	m_GameID = 0;
+}
+
+CReplayDB :: ~CReplayDB( )
+{
+	Flush( );
+}
+
+void CReplayDB :: AddRow( int file, string row )
+{
+	m_Rows[file] += row + "\n";
+
+	if( m_Rows[file].size( ) >= 1048576 )
+		Flush( );
+}
+
+void CReplayDB :: Flush( )
+{
+	m_Output->Write( m_Rows );
+}
+
+CCallableDotAEventAdd *CReplayDB :: ThreadedDotAEventAdd( uint32_t gameid, string gamename, string Killer, string Victim, uint32_t kcolour, uint32_t vcolour )
+{
+	// the stats class doesn't know the game id when the game is in progress so it passes 0
+
+	AddRow( CReplayOutput :: OUTPUT_DOTAEVENTS, UTIL_ToString( m_GameID ) + "\t" + UTIL_ToString( gameid ) + "\t" + EscapeField( gamename ) + "\t" + EscapeField( Killer ) + "\t" + EscapeField( Victim ) + "\t" + UTIL_ToString( kcolour ) + "\t" + UTIL_ToString( vcolour ) );
+	return NULL;
+}
+
+CCallableDotAGameAdd *CReplayDB :: ThreadedDotAGameAdd( uint32_t gameid, uint32_t winner, uint32_t min, uint32_t sec )
+{
+	AddRow( CReplayOutput :: OUTPUT_DOTAGAMES, UTIL_ToString( gameid ) + "\t" + UTIL_ToString( winner ) + "\t" + UTIL_ToString( min ) + "\t" + UTIL_ToString( sec ) );
+	return NULL;
+}
+
+CCallableDotAPlayerAdd *CReplayDB :: ThreadedDotAPlayerAdd( uint32_t gameid, string name, uint32_t colour, uint32_t kills, uint32_t deaths, uint32_t creepkills, uint32_t creepdenies, uint32_t assists, uint32_t gold, uint32_t neutralkills, string item1, string item2, string item3, string item4, string item5, string item6, string hero, uint32_t newcolour, uint32_t towerkills, uint32_t raxkills, uint32_t courierkills, uint32_t outcome, uint32_t level, uint32_t apm )
+{
+	string Row = UTIL_ToString( gameid ) + "\t" + EscapeField( name ) + "\t" + UTIL_ToString( colour ) + "\t" + UTIL_ToString( kills ) + "\t" + UTIL_ToString( deaths ) + "\t" + UTIL_ToString( creepkills ) + "\t" + UTIL_ToString( creepdenies ) + "\t" + UTIL_ToString( assists ) + "\t" + UTIL_ToString( gold ) + "\t" + UTIL_ToString( neutralkills );
+	Row += "\t" + EscapeField( item1 ) + "\t" + EscapeField( item2 ) + "\t" + EscapeField( item3 ) + "\t" + EscapeField( item4 ) + "\t" + EscapeField( item5 ) + "\t" + EscapeField( item6 ) + "\t" + EscapeField( hero );
+	Row += "\t" + UTIL_ToString( newcolour ) + "\t" + UTIL_ToString( towerkills ) + "\t" + UTIL_ToString( raxkills ) + "\t" + UTIL_ToString( courierkills ) + "\t" + UTIL_ToString( outcome ) + "\t" + UTIL_ToString( level ) + "\t" + UTIL_ToString( apm );
+	AddRow( CReplayOutput :: OUTPUT_DOTAPLAYERS, Row );
+	return NULL;
+}
+
+CCallableW3MMDPlayerAdd *CReplayDB :: ThreadedW3MMDPlayerAdd( string category, uint32_t gameid, uint32_t pid, string name, string flag, uint32_t leaver, uint32_t practicing )
+{
+	AddRow( CReplayOutput :: OUTPUT_W3MMDPLAYERS, EscapeField( category ) + "\t" + UTIL_ToString( gameid ) + "\t" + UTIL_ToString( pid ) + "\t" + EscapeField( name ) + "\t" + EscapeField( flag ) + "\t" + UTIL_ToString( leaver ) + "\t" + UTIL_ToString( practicing ) );
+	return NULL;
+}
+
+CCallableW3MMDVarAdd *CReplayDB :: ThreadedW3MMDVarAdd( uint32_t gameid, map<VarP,int32_t> var_ints )
+{
+	for( map<VarP,int32_t> :: iterator i = var_ints.begin( ); i != var_ints.end( ); i++ )
+		AddRow( CReplayOutput :: OUTPUT_W3MMDVARS, UTIL_ToString( gameid ) + "\t" + UTIL_ToString( i->first.first ) + "\t" + EscapeField( i->first.second ) + "\t" + UTIL_ToString( i->second ) + "\t\\N\t\\N" );
+
+	return NULL;
+}
+
+CCallableW3MMDVarAdd *CReplayDB :: ThreadedW3MMDVarAdd( uint32_t gameid, map<VarP,double> var_reals )
+{
+	for( map<VarP,double> :: iterator i = var_reals.begin( ); i != var_reals.end( ); i++ )
+		AddRow( CReplayOutput :: OUTPUT_W3MMDVARS, UTIL_ToString( gameid ) + "\t" + UTIL_ToString( i->first.first ) + "\t" + EscapeField( i->first.second ) + "\t\\N\t" + UTIL_ToString( i->second, 10 ) + "\t\\N" );
+
+	return NULL;
+}
+
+CCallableW3MMDVarAdd *CReplayDB :: ThreadedW3MMDVarAdd( uint32_t gameid, map<VarP,string> var_strings )
+{
+	for( map<VarP,string> :: iterator i = var_strings.begin( ); i != var_strings.end( ); i++ )
+		AddRow( CReplayOutput :: OUTPUT_W3MMDVARS, UTIL_ToString( gameid ) + "\t" + UTIL_ToString( i->first.first ) + "\t" + EscapeField( i->first.second ) + "\t\\N\t\\N\t" + EscapeField( i->second ) );
+
+	return NULL;
+}
+
+//
+// CReplayGame
+//
+
+// the game as seen by the stats classes, reconstructed from the replay header
+
+class CReplayGame : public CStatsGame
+{
+private:
+	string m_GameName;
+	map<uint32_t, string> m_ColourToName;
+	uint32_t m_Ticks;								// the game time in milliseconds, advanced by each time slot
+
+public:
+	CReplayGame( CReplay *replay );
+	virtual ~CReplayGame( );
+
+	void AddTicks( uint32_t ticks )					{ m_Ticks += ticks; }
+
+	virtual string GetGameName( )					{ return m_GameName; }
+	virtual uint32_t GetStatsTime( )				{ return m_Ticks / 1000; }
+	virtual string GetStatsPlayerName( uint32_t colour );
+	virtual void SetStatsPlayerTeam( uint32_t colour, uint32_t team )	{ }
+	virtual void EventStatsGameStart( )				{ }
+	virtual void AddStatsCallable( CBaseCallable *callable )			{ delete callable; }
+};
+
+CReplayGame :: CReplayGame( CReplay *replay )
+{
+	m_GameName = replay->GetGameName( );
+	m_Ticks = 0;
+
+	vector<PIDPlayer> Players = replay->GetPlayers( );
+	vector<CGameSlot> Slots = replay->GetSlots( );
+
+	for( vector<CGameSlot> :: iterator i = Slots.begin( ); i != Slots.end( ); i++ )
+	{
+		if( (*i).GetSlotStatus( ) != SLOTSTATUS_OCCUPIED || (*i).GetComputer( ) )
+			continue;
+
+		for( vector<PIDPlayer> :: iterator j = Players.begin( ); j != Players.end( ); j++ )
+		{
+			if( (*j).first == (*i).GetPID( ) )
+				m_ColourToName[(*i).GetColour( )] = (*j).second;
+		}
+	}
+}
+
+CReplayGame :: ~CReplayGame( )
+{
+
+}
+
+string CReplayGame :: GetStatsPlayerName( uint32_t colour )
+{
+	map<uint32_t, string> :: iterator i = m_ColourToName.find( colour );
+
+	if( i != m_ColourToName.end( ) )
+		return i->second;
+
+	return string( );
+}
+
+//
+// CReplayAnalyzer
+//
+
+class CReplayAnalyzer
+{
+private:
+	CConfig *m_CFG;
+	CReplayOutput *m_Output;
+	vector<string> m_Files;
+	uint32_t m_FirstGameID;
+	string m_StatsType;
+	string m_W3MMDCategory;
+	boost::mutex m_Mutex;
+	uint32_t m_NextFile;
+	uint32_t m_Processed;
+	uint32_t m_Failed;
+	uint64_t m_Bytes;
+
+public:
+	CReplayAnalyzer( CConfig *nCFG, CReplayOutput *nOutput, vector<string> nFiles, uint32_t nFirstGameID, string nStatsType, string nW3MMDCategory );
+	~CReplayAnalyzer( );
+
+	uint32_t GetProcessed( )	{ return m_Processed; }
+	uint32_t GetFailed( )		{ return m_Failed; }
+	uint64_t GetBytes( )		{ return m_Bytes; }
+
+	void WorkerThread( );
+	bool Analyze( CReplayDB *DB, string file, uint32_t gameID, uint32_t *bytes );
+};
+
+CReplayAnalyzer :: CReplayAnalyzer( CConfig *nCFG, CReplayOutput *nOutput, vector<string> nFiles, uint32_t nFirstGameID, string nStatsType, string nW3MMDCategory )
+{
+	m_CFG = nCFG;
+	m_Output = nOutput;
+	m_Files = nFiles;
+	m_FirstGameID = nFirstGameID;
+	m_StatsType = nStatsType;
+	m_W3MMDCategory = nW3MMDCategory;
+	m_NextFile = 0;
+	m_Processed = 0;
+	m_Failed = 0;
+	m_Bytes = 0;
+}
+
+CReplayAnalyzer :: ~CReplayAnalyzer( )
+{
+
+}
+
+void CReplayAnalyzer :: WorkerThread( )
+{
+	// each worker has its own database so the rows are only shared when they're flushed to the output files
+
+	CReplayDB DB( m_CFG, m_Output );
+
+	while( true )
+	{
+		uint32_t File;
+
+		{
+			boost::mutex :: scoped_lock Lock( m_Mutex );
+
+			if( m_NextFile >= m_Files.size( ) )
+				break;
+
+			File = m_NextFile++;
+		}
+
+		uint32_t Bytes = 0;
+		bool Success = Analyze( &DB, m_Files[File], m_FirstGameID + File, &Bytes );
+
+		boost::mutex :: scoped_lock Lock( m_Mutex );
+		m_Processed++;
+		m_Bytes += Bytes;
+
+		if( !Success )
+			m_Failed++;
+	}
+}
+
+bool CReplayAnalyzer :: Analyze( CReplayDB *DB, string file, uint32_t gameID, uint32_t *bytes )
+{
+	CReplay Replay;
+	Replay.Load( file, false );
+	*bytes = Replay.GetCompressedSize( );
+
+	if( Replay.GetValid( ) )
+		Replay.ParseReplay( true );
+
+	if( !Replay.GetValid( ) )
+	{
+		boost::mutex :: scoped_lock Lock( gConsoleMutex );
+		cout << "warning: unable to parse replay [" << file << "], skipping" << endl;
+		return false;
+	}
+
+	CReplayGame Game( &Replay );
+	CStatsDOTA *StatsDOTA = NULL;
+	CStatsW3MMD *StatsW3MMD = NULL;
+
+	if( m_StatsType == "w3mmd" )
+		StatsW3MMD = new CStatsW3MMD( &Game, m_W3MMDCategory );
+	else
+		StatsDOTA = new CStatsDOTA( &Game );
+
+	DB->SetGameID( gameID );
+	DB->AddRow( CReplayOutput :: OUTPUT_GAMES, UTIL_ToString( gameID ) + "\t" + EscapeField( file ) + "\t" + EscapeField( Replay.GetGameName( ) ) + "\t" + UTIL_ToString( Replay.GetReplayLength( ) ) );
+
+	// replay the actions in each time slot through the stats class
+	// time slot format: time increment (2 bytes) then for each player: pid (1 byte), action length (2 bytes), action data
+
+	queue<BYTEARRAY> *Blocks = Replay.GetBlocks( );
+	BYTEARRAY CRC;
+
+	while( !Blocks->empty( ) )
+	{
+		BYTEARRAY &Block = Blocks->front( );
+
+		if( Block.size( ) >= 5 && Block[0] == CReplay :: REPLAY_TIMESLOT )
+		{
+			Game.AddTicks( Block[3] | Block[4] << 8 );
+			uint32_t Position = 5;
+
+			while( Position + 3 <= Block.size( ) )
+			{
+				unsigned char PID = Block[Position];
+				uint16_t Length = Block[Position + 1] | Block[Position + 2] << 8;
+				Position += 3;
+
+				if( Position + Length > Block.size( ) )
+					break;
+
+				BYTEARRAY ActionData( Block.begin( ) + Position, Block.begin( ) + Position + Length );
+				CIncomingAction Action( PID, CRC, ActionData );
+				Position += Length;
+
+				if( StatsDOTA )
+					StatsDOTA->ProcessAction( &Action, DB, NULL );
+				else
+					StatsW3MMD->ProcessAction( &Action );
+			}
+		}
+
+		Blocks->pop( );
+	}
+
+	// the stats classes look up the players by colour when saving
+
+	vector<CDBGamePlayer *> DBGamePlayers;
+	vector<CGameSlot> Slots = Replay.GetSlots( );
+
+	for( vector<CGameSlot> :: iterator i = Slots.begin( ); i != Slots.end( ); i++ )
+	{
+		string Name = Game.GetStatsPlayerName( (*i).GetColour( ) );
+
+		if( !Name.empty( ) )
+			DBGamePlayers.push_back( new CDBGamePlayer( 0, gameID, Name, string( ), 0, string( ), 0, 0, 0, string( ), (*i).GetTeam( ), (*i).GetColour( ) ) );
+	}
+
+	if( StatsDOTA )
+		StatsDOTA->Save( NULL, DBGamePlayers, DB, gameID );
+	else
+		StatsW3MMD->Save( NULL, DB, gameID );
+
+	for( vector<CDBGamePlayer *> :: iterator i = DBGamePlayers.begin( ); i != DBGamePlayers.end( ); i++ )
+		delete *i;
+
+	delete StatsDOTA;
+	delete StatsW3MMD;
+	return true;
+}
+
+int main( int argc, char **argv )
+{
+	string CFGFile = "analyze_replays.cfg";
+
+	if( argc > 1 && argv[1] )
+		CFGFile = argv[1];
+
+	CConfig CFG;
+	CFG.Read( CFGFile );
+	string ReplayPath = CFG.GetString( "replay_path", "../replays/" );
+	string OutputPath = CFG.GetString( "output_path", "./" );
+	string StatsType = CFG.GetString( "stats", "dota" );
+	string W3MMDCategory = CFG.GetString( "w3mmd_category", string( ) );
+	uint32_t FirstGameID = CFG.GetInt( "firstgameid", 1 );
+	uint32_t NumThreads = CFG.GetInt( "threads", 0 );
+	gVerbose = CFG.GetInt( "verbose", 0 ) == 0 ? false : true;
+
+	// don't even build the messages we won't print
+
+	if( !gVerbose )
+	{
+		for( uint32_t i = 0; i < LOGCAT_NUMCATEGORIES; i++ )
+			gLogLevels[i] = LOGLEVEL_ERROR;
+	}
+
+	if( NumThreads == 0 )
+		NumThreads = boost::thread :: hardware_concurrency( );
+
+	if( NumThreads == 0 )
+		NumThreads = 1;
+
+	if( StatsType != "dota" && StatsType != "w3mmd" )
+	{
+		cout << "error: unknown stats type [" << StatsType << "], expected dota or w3mmd" << endl;
+		return 1;
+	}
+
+	// find the replays
+	// they're sorted so the game ids are the same every time the tool is run on the same directory
+
+	vector<string> Files;
+
+	try
+	{
+		boost::filesystem::path ReplayDir( ReplayPath );
+
+		if( !boost::filesystem::exists( ReplayDir ) || !boost::filesystem::is_directory( ReplayDir ) )
+		{
+			cout << "error: replay path [" << ReplayPath << "] doesn't exist or isn't a directory" << endl;
+			return 1;
+		}
+
+		for( boost::filesystem::directory_iterator i( ReplayDir ); i != boost::filesystem::directory_iterator( ); i++ )
+		{
+			string FileName = i->path( ).string( );
+			transform( FileName.begin( ), FileName.end( ), FileName.begin( ), (int(*)(int))tolower );
+
+			if( !boost::filesystem::is_directory( i->status( ) ) && FileName.size( ) > 4 && FileName.substr( FileName.size( ) - 4 ) == ".w3g" )
+				Files.push_back( i->path( ).string( ) );
+		}
+	}
+	catch( const exception &ex )
+	{
+		cout << "error: unable to list replays in [" << ReplayPath << "] - " << ex.what( ) << endl;
+		return 1;
+	}
+
+	sort( Files.begin( ), Files.end( ) );
+
+	CReplayOutput Output;
+
+	if( !Output.Open( OutputPath ) )
+		return 1;
+
+	cout << "analyzing " << Files.size( ) << " replays in [" << ReplayPath << "] with " << NumThreads << " threads using " << StatsType << " stats" << endl;
+
+	uint32_t StartTicks = GetTicks( );
+	CReplayAnalyzer Analyzer( &CFG, &Output, Files, FirstGameID, StatsType, W3MMDCategory );
+	boost::thread_group Workers;
+
+	for( uint32_t i = 0; i < NumThreads; i++ )
+		Workers.create_thread( boost::bind( &CReplayAnalyzer :: WorkerThread, &Analyzer ) );
+
+	Workers.join_all( );
+	Output.Close( );
+
+	// throughput report
+
+	uint32_t Elapsed = GetTicks( ) - StartTicks;
+	double Seconds = Elapsed > 0 ? Elapsed / 1000.0 : 0.001;
+	cout << "processed " << Analyzer.GetProcessed( ) << " replays (" << Analyzer.GetFailed( ) << " failed) in " << UTIL_ToString( Seconds, 2 ) << " seconds" << endl;
+	cout << "throughput: " << UTIL_ToString( Analyzer.GetProcessed( ) / Seconds, 2 ) << " replays/second, " << UTIL_ToString( Analyzer.GetBytes( ) / 1048576.0 / Seconds, 2 ) << " MB/second" << endl;
+	return 0;
+}
@@ -0,0 +1,224 @@
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#include "ghost.h"
+#include "util.h"
+#include "ghostdb.h"
+#include "ipblacklist.h"
+#include "banlist.h"
+
+// returns true and sets key if ip is a CIDR block or a wildcard rather than a single address
+
+static bool GetBlockKey( const string &ip, uint64_t &key, uint32_t &length )
+{
+	uint32_t Address;
+
+	if( ip.find_first_of( "/*" ) == string :: npos || !ParseIPBlock( ip, Address, length ) )
+		return false;
+
+	key = ( (uint64_t)length << 32 ) | Address;
+	return true;
+}
+
+// returns the first IP ban in the range or the first ban if none of them are IP bans
+
+template <class Iterator> static CDBBan *PickBan( pair<Iterator, Iterator> range, CDBBan *best )
+{
+	for( Iterator i = range.first; i != range.second; i++ )
+	{
+		if( i->second->GetIPBan( ) )
+			return i->second;
+
+		if( !best )
+			best = i->second;
+	}
+
+	return best;
+}
+
+//
+// CBanList
+//
+
+CBanList :: CBanList( string nServer )
+{
+	m_Server = nServer;
+	m_MaxID = 0;
+	m_Total = 0;
+
+	for( uint32_t i = 0; i <= 32; i++ )
+		m_BlockLengths[i] = 0;
+}
+
+CBanList :: ~CBanList( )
+{
+	for( boost::unordered_multimap<string, CDBBan *> :: iterator i = m_Names.begin( ); i != m_Names.end( ); i++ )
+		delete i->second;
+}
+
+void CBanList :: AddBan( CDBBan *ban )
+{
+	string Name = ban->GetName( );
+	transform( Name.begin( ), Name.end( ), Name.begin( ), (int(*)(int))tolower );
+
+	if( ban->GetID( ) != 0 )
+	{
+		// this ban came from the database, if it was added locally in the meantime the local copy doesn't have an id yet
+
+		pair<boost::unordered_multimap<string, CDBBan *> :: iterator, boost::unordered_multimap<string, CDBBan *> :: iterator> Range = m_Names.equal_range( Name );
+
+		for( boost::unordered_multimap<string, CDBBan *> :: iterator i = Range.first; i != Range.second; )
+		{
+			if( i->second->GetID( ) == 0 )
+			{
+				RemoveIP( i->second );
+				delete i->second;
+				i = m_Names.erase( i );
+			}
+			else
+				i++;
+		}
+
+		if( ban->GetID( ) > m_MaxID )
+			m_MaxID = ban->GetID( );
+	}
+
+	m_Names.insert( make_pair( Name, ban ) );
+
+	if( ban->GetIP( ).empty( ) )
+		return;
+
+	uint64_t Key;
+	uint32_t Length;
+
+	if( GetBlockKey( ban->GetIP( ), Key, Length ) )
+	{
+		m_Blocks.insert( make_pair( Key, ban ) );
+		m_BlockLengths[Length]++;
+	}
+	else
+		m_IPs.insert( make_pair( ban->GetIP( ), ban ) );
+}
+
+void CBanList :: RemoveBans( string name )
+{
+	transform( name.begin( ), name.end( ), name.begin( ), (int(*)(int))tolower );
+	pair<boost::unordered_multimap<string, CDBBan *> :: iterator, boost::unordered_multimap<string, CDBBan *> :: iterator> Range = m_Names.equal_range( name );
+
+	for( boost::unordered_multimap<string, CDBBan *> :: iterator i = Range.first; i != Range.second; i++ )
+	{
+		RemoveIP( i->second );
+		delete i->second;
+	}
+
+	m_Names.erase( Range.first, Range.second );
+}
+
+void CBanList :: Merge( CBanList *delta )
+{
+	for( boost::unordered_multimap<string, CDBBan *> :: iterator i = delta->m_Names.begin( ); i != delta->m_Names.end( ); i++ )
+		AddBan( i->second );
+
+	delta->m_Names.clear( );
+	delta->m_IPs.clear( );
+	delta->m_Blocks.clear( );
+
+	for( uint32_t i = 0; i <= 32; i++ )
+		delta->m_BlockLengths[i] = 0;
+}
+
+CDBBan *CBanList :: GetBanByName( string name )
+{
+	transform( name.begin( ), name.end( ), name.begin( ), (int(*)(int))tolower );
+	boost::unordered_multimap<string, CDBBan *> :: iterator i = m_Names.find( name );
+
+	if( i != m_Names.end( ) )
+		return i->second;
+
+	return NULL;
+}
+
+CDBBan *CBanList :: GetBanByIP( string ip )
+{
+	CDBBan *Ban = PickBan( m_IPs.equal_range( ip ), NULL );
+
+	if( Ban && Ban->GetIPBan( ) )
+		return Ban;
+
+	if( m_Blocks.empty( ) )
+		return Ban;
+
+	uint32_t Address;
+	uint32_t Length;
+
+	if( !ParseIPBlock( ip, Address, Length ) || Length != 32 )
+		return Ban;
+
+	for( uint32_t i = 0; i <= 32; i++ )
+	{
+		if( m_BlockLengths[i] == 0 )
+			continue;
+
+		uint64_t Key = ( (uint64_t)i << 32 ) | ( i == 0 ? 0 : Address & ( 0xFFFFFFFF << ( 32 - i ) ) );
+		Ban = PickBan( m_Blocks.equal_range( Key ), Ban );
+
+		if( Ban && Ban->GetIPBan( ) )
+			return Ban;
+	}
+
+	return Ban;
+}
+
+void CBanList :: RemoveIP( CDBBan *ban )
+{
+	if( ban->GetIP( ).empty( ) )
+		return;
+
+	uint64_t Key;
+	uint32_t Length;
+
+	if( GetBlockKey( ban->GetIP( ), Key, Length ) )
+	{
+		pair<boost::unordered_multimap<uint64_t, CDBBan *> :: iterator, boost::unordered_multimap<uint64_t, CDBBan *> :: iterator> Range = m_Blocks.equal_range( Key );
+
+		for( boost::unordered_multimap<uint64_t, CDBBan *> :: iterator i = Range.first; i != Range.second; i++ )
+		{
+			if( i->second == ban )
+			{
+				m_Blocks.erase( i );
+				m_BlockLengths[Length]--;
+				return;
+			}
+		}
+	}
+	else
+	{
+		pair<boost::unordered_multimap<string, CDBBan *> :: iterator, boost::unordered_multimap<string, CDBBan *> :: iterator> Range = m_IPs.equal_range( ban->GetIP( ) );
+
+		for( boost::unordered_multimap<string, CDBBan *> :: iterator i = Range.first; i != Range.second; i++ )
+		{
+			if( i->second == ban )
+			{
+				m_IPs.erase( i );
+				return;
+			}
+		}
+	}
+}
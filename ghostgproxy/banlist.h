@@ -0,0 +1,67 @@
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#ifndef BANLIST_H
+#define BANLIST_H
+
+#include <boost/unordered_map.hpp>
+
+class CDBBan;
+
+//
+// CBanList
+//
+
+// the cached bans for one realm, indexed by lowercase name and by IP address so checking a joining player doesn't have to look at every ban
+// a ban's IP address can also be a CIDR block (1.2.3.0/24) or a wildcard (1.2.3.*), these are indexed by prefix length and checked with one lookup per prefix length in use
+// the list owns its bans, CBNET loads a complete list in the background every hour and swaps it in, in between it merges in the bans added since (see CBNET :: Update)
+
+class CBanList
+{
+private:
+	string m_Server;
+	uint32_t m_MaxID;											// the highest database id in the list, a delta refresh only fetches bans with a higher id
+	uint32_t m_Total;											// the number of bans on the realm in the database when the list was fetched
+	boost::unordered_multimap<string, CDBBan *> m_Names;		// every ban, keyed by lowercase name
+	boost::unordered_multimap<string, CDBBan *> m_IPs;			// the bans on a single IP address, keyed by address
+	boost::unordered_multimap<uint64_t, CDBBan *> m_Blocks;	// the bans on a CIDR block, keyed by the prefix length in the high 32 bits and the block's first address in the low 32 bits
+	uint32_t m_BlockLengths[33];								// the number of bans on CIDR blocks of each prefix length
+
+	void RemoveIP( CDBBan *ban );
+
+public:
+	CBanList( string nServer );
+	~CBanList( );
+
+	string GetServer( )				{ return m_Server; }
+	uint32_t GetMaxID( )			{ return m_MaxID; }
+	uint32_t GetTotal( )			{ return m_Total; }
+	uint32_t GetNumBans( )			{ return m_Names.size( ); }
+
+	void SetTotal( uint32_t nTotal )	{ m_Total = nTotal; }
+
+	void AddBan( CDBBan *ban );				// the list takes ownership, a ban from the database replaces a ban with the same name that was added locally and doesn't have an id yet
+	void RemoveBans( string name );			// removes and deletes every ban on this name
+	void Merge( CBanList *delta );			// moves every ban from delta into this list
+	CDBBan *GetBanByName( string name );
+	CDBBan *GetBanByIP( string ip );		// if there's more than one ban on this address an IP ban is returned first
+};
+
+#endif
@@ -0,0 +1,203 @@
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#include "ghost.h"
+#include "util.h"
+#include "bnetprotocol.h"
+#include "bnetqueue.h"
+
+//
+// CBNETOutQueue
+//
+
+CBNETOutQueue :: CBNETOutQueue( uint32_t nFloodBurst, uint32_t nFloodBase, uint32_t nFloodPerByte )
+{
+	// the burst has to cover at least one packet or we'd never send anything
+
+	m_FloodBurst = nFloodBurst < 1 ? 1 : nFloodBurst;
+	m_FloodBase = nFloodBase;
+	m_FloodPerByte = nFloodPerByte;
+	m_Tokens = m_FloodBurst;
+	m_LastRefillTicks = GetTicks( );
+
+	for( uint32_t i = 0; i < OUTPACKET_NUMCLASSES; i++ )
+	{
+		m_Sent[i] = 0;
+		m_Merged[i] = 0;
+		m_Dropped[i] = 0;
+		m_Latency[i] = new CHistogram( 64 );
+	}
+}
+
+CBNETOutQueue :: ~CBNETOutQueue( )
+{
+	for( uint32_t i = 0; i < OUTPACKET_NUMCLASSES; i++ )
+		delete m_Latency[i];
+}
+
+uint32_t CBNETOutQueue :: GetLimit( uint32_t packetClass )
+{
+	// game packets are never discarded, refreshes replace each other so they can't pile up
+
+	static const uint32_t Limits[] = { 0xFFFFFFFF, 30, 20, 10 };
+	return Limits[packetClass];
+}
+
+string CBNETOutQueue :: GetClassName( uint32_t packetClass )
+{
+	static const char *Names[] = { "game", "admin", "whisper", "public" };
+	return Names[packetClass];
+}
+
+uint32_t CBNETOutQueue :: GetSize( )
+{
+	uint32_t Size = 0;
+
+	for( uint32_t i = 0; i < OUTPACKET_NUMCLASSES; i++ )
+		Size += m_Queues[i].size( );
+
+	return Size;
+}
+
+uint32_t CBNETOutQueue :: GetCost( uint32_t size )
+{
+	uint64_t Cost = m_FloodBase + (uint64_t)m_FloodPerByte * size;
+	return Cost > m_FloodBurst ? m_FloodBurst : (uint32_t)Cost;
+}
+
+bool CBNETOutQueue :: Push( const BYTEARRAY &packet, uint32_t packetClass )
+{
+	deque<CBNETOutPacket> &Queue = m_Queues[packetClass];
+
+	if( packetClass == OUTPACKET_GAME )
+	{
+		// a game refresh supersedes the previous one if nothing was queued after it
+		// we keep the old queued time so the latency shows how long the game went without a refresh
+
+		if( packet.size( ) >= 2 && packet[1] == CBNETProtocol :: SID_STARTADVEX3 && !Queue.empty( ) && Queue.back( ).m_Data.size( ) >= 2 && Queue.back( ).m_Data[1] == CBNETProtocol :: SID_STARTADVEX3 )
+		{
+			Queue.back( ).m_Data = packet;
+			m_Merged[packetClass]++;
+			return true;
+		}
+	}
+	else
+	{
+		for( deque<CBNETOutPacket> :: iterator i = Queue.begin( ); i != Queue.end( ); i++ )
+		{
+			if( i->m_Data == packet )
+			{
+				m_Merged[packetClass]++;
+				return true;
+			}
+		}
+	}
+
+	if( Queue.size( ) >= GetLimit( packetClass ) )
+	{
+		m_Dropped[packetClass]++;
+		return false;
+	}
+
+	Queue.push_back( CBNETOutPacket( packet ) );
+	return true;
+}
+
+bool CBNETOutQueue :: Pop( BYTEARRAY &packet )
+{
+	uint32_t Ticks = GetTicks( );
+	uint64_t Tokens = m_Tokens + (uint64_t)( Ticks - m_LastRefillTicks );
+	m_Tokens = Tokens > m_FloodBurst ? m_FloodBurst : (uint32_t)Tokens;
+	m_LastRefillTicks = Ticks;
+
+	for( uint32_t i = 0; i < OUTPACKET_NUMCLASSES; i++ )
+	{
+		if( m_Queues[i].empty( ) )
+			continue;
+
+		// only the first packet of the highest priority class can be sent, if we can't afford it we wait rather than letting a cheaper packet overtake it
+
+		CBNETOutPacket &Packet = m_Queues[i].front( );
+		uint32_t Cost = GetCost( Packet.m_Data.size( ) );
+
+		if( m_Tokens < Cost )
+			return false;
+
+		m_Tokens -= Cost;
+		m_Sent[i]++;
+		m_Latency[i]->Add( Ticks - Packet.m_QueuedTicks );
+		packet.swap( Packet.m_Data );
+		m_Queues[i].pop_front( );
+		return true;
+	}
+
+	return false;
+}
+
+uint32_t CBNETOutQueue :: Remove( unsigned char type )
+{
+	uint32_t Removed = 0;
+
+	for( uint32_t i = 0; i < OUTPACKET_NUMCLASSES; i++ )
+	{
+		for( deque<CBNETOutPacket> :: iterator j = m_Queues[i].begin( ); j != m_Queues[i].end( ); )
+		{
+			if( j->m_Data.size( ) >= 2 && j->m_Data[1] == type )
+			{
+				j = m_Queues[i].erase( j );
+				Removed++;
+			}
+			else
+				j++;
+		}
+	}
+
+	return Removed;
+}
+
+uint32_t CBNETOutQueue :: Remove( const BYTEARRAY &packet )
+{
+	uint32_t Removed = 0;
+
+	for( uint32_t i = 0; i < OUTPACKET_NUMCLASSES; i++ )
+	{
+		for( deque<CBNETOutPacket> :: iterator j = m_Queues[i].begin( ); j != m_Queues[i].end( ); )
+		{
+			if( j->m_Data == packet )
+			{
+				j = m_Queues[i].erase( j );
+				Removed++;
+			}
+			else
+				j++;
+		}
+	}
+
+	return Removed;
+}
+
+void CBNETOutQueue :: Clear( )
+{
+	for( uint32_t i = 0; i < OUTPACKET_NUMCLASSES; i++ )
+		m_Queues[i].clear( );
+
+	m_Tokens = m_FloodBurst;
+	m_LastRefillTicks = GetTicks( );
+}
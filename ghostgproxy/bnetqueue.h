@@ -0,0 +1,89 @@
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#ifndef BNETQUEUE_H
+#define BNETQUEUE_H
+
+#include "metrics.h"
+
+// the classes of packets queued for battle.net, a packet is only sent when every class before it is empty
+
+#define OUTPACKET_GAME			0		// game creation, refreshes and uncreation and entering chat, these keep their order
+#define OUTPACKET_ADMIN			1		// chat commands to or on behalf of admins
+#define OUTPACKET_WHISPER		2		// whispers to everyone else, including spoof checks
+#define OUTPACKET_PUBLIC		3		// messages to the channel
+#define OUTPACKET_NUMCLASSES	4
+
+//
+// CBNETOutPacket
+//
+
+class CBNETOutPacket
+{
+public:
+	BYTEARRAY m_Data;
+	uint32_t m_QueuedTicks;
+
+	CBNETOutPacket( const BYTEARRAY &nData ) : m_Data( nData ), m_QueuedTicks( GetTicks( ) ) { }
+};
+
+//
+// CBNETOutQueue
+//
+
+// schedules the packets we send to battle.net so we don't get kicked for flooding
+// sending a packet costs floodbase + floodperbyte * size tokens (capped at floodburst), tokens are earned at one per millisecond up to floodburst
+// so with the defaults a small packet costs about 1 second and a big one 3.5 seconds, and after being idle we can send one big packet right away
+// a game refresh replaces a refresh that's still queued and a chat command that's already queued in the same class isn't queued twice
+
+class CBNETOutQueue
+{
+private:
+	deque<CBNETOutPacket> m_Queues[OUTPACKET_NUMCLASSES];
+	uint32_t m_FloodBurst;
+	uint32_t m_FloodBase;
+	uint32_t m_FloodPerByte;
+	uint32_t m_Tokens;
+	uint32_t m_LastRefillTicks;
+
+public:
+	uint32_t m_Sent[OUTPACKET_NUMCLASSES];			// packets sent
+	uint32_t m_Merged[OUTPACKET_NUMCLASSES];		// packets that replaced or duplicated a queued packet
+	uint32_t m_Dropped[OUTPACKET_NUMCLASSES];		// packets discarded because the queue was full
+	CHistogram *m_Latency[OUTPACKET_NUMCLASSES];	// milliseconds each packet waited in the queue
+
+	CBNETOutQueue( uint32_t nFloodBurst, uint32_t nFloodBase, uint32_t nFloodPerByte );
+	~CBNETOutQueue( );
+
+	static uint32_t GetLimit( uint32_t packetClass );
+	static string GetClassName( uint32_t packetClass );
+
+	uint32_t GetSize( );
+	uint32_t GetSize( uint32_t packetClass )	{ return m_Queues[packetClass].size( ); }
+	uint32_t GetCost( uint32_t size );
+
+	bool Push( const BYTEARRAY &packet, uint32_t packetClass );		// returns false if the packet was discarded because the queue is full
+	bool Pop( BYTEARRAY &packet );									// returns false if there's nothing to send or we have to wait
+	uint32_t Remove( unsigned char type );							// removes every queued packet with this packet ID
+	uint32_t Remove( const BYTEARRAY &packet );						// removes every queued copy of this packet
+	void Clear( );
+};
+
+#endif
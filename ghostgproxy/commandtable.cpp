@@ -0,0 +1,96 @@
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+#include "ghost.h"
+#include "util.h"
+#include "metrics.h"
+#include "commandtable.h"
+
+//
+// CCommand
+//
+
+CCommand :: CCommand( uint32_t nID, string nName, uint32_t nAccess ) : m_ID( nID ), m_Name( nName ), m_Access( nAccess )
+{
+	m_Time = new CHistogram( 16 );
+}
+
+CCommand :: ~CCommand( )
+{
+	delete m_Time;
+}
+
+//
+// CCommandTable
+//
+
+CCommandTable :: CCommandTable( string nName ) : m_Name( nName )
+{
+
+}
+
+CCommandTable :: ~CCommandTable( )
+{
+	for( vector<CCommand *> :: iterator i = m_Commands.begin( ); i != m_Commands.end( ); i++ )
+		delete *i;
+}
+
+void CCommandTable :: Register( uint32_t id, uint32_t access, string names )
+{
+	vector<string> Names = UTIL_Tokenize( names, ' ' );
+
+	if( Names.empty( ) )
+		return;
+
+	CCommand *Command = new CCommand( id, Names[0], access );
+	m_Commands.push_back( Command );
+
+	for( vector<string> :: iterator i = Names.begin( ); i != Names.end( ); i++ )
+	{
+		if( m_Names.find( *i ) != m_Names.end( ) )
+			CONSOLE_Print( "[GHOST] warning - " + m_Name + " command [" + *i + "] is registered twice, ignoring the second registration" );
+		else
+			m_Names[*i] = Command;
+	}
+}
+
+CCommand *CCommandTable :: Find( const string &name )
+{
+	boost::unordered_map<string, CCommand *> :: iterator i = m_Names.find( name );
+
+	if( i != m_Names.end( ) )
+		return i->second;
+
+	return NULL;
+}
+
+//
+// CCommandScope
+//
+
+CCommandScope :: CCommandScope( CCommand *nCommand ) : m_Command( nCommand ), m_StartTicks( GetMicroTicks( ) )
+{
+
+}
+
+CCommandScope :: ~CCommandScope( )
+{
+	if( m_Command )
+		m_Command->GetTime( )->Add( GetMicroTicks( ) - m_StartTicks );
+}
@@ -0,0 +1,96 @@
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+#ifndef COMMANDTABLE_H
+#define COMMANDTABLE_H
+
+#include <boost/unordered_map.hpp>
+
+// who may use a command, a user with a higher level may use every command of a lower level
+
+#define CMDACCESS_ANYONE	0
+#define CMDACCESS_ADMIN		1
+
+class CHistogram;
+
+//
+// CCommand
+//
+
+class CCommand
+{
+private:
+	uint32_t m_ID;					// what the dispatcher switches on, every alias of a command has the same id
+	string m_Name;					// the first name the command was registered with
+	uint32_t m_Access;
+	CHistogram *m_Time;				// microseconds spent handling each invocation, its count is the number of invocations
+
+public:
+	CCommand( uint32_t nID, string nName, uint32_t nAccess );
+	~CCommand( );
+
+	uint32_t GetID( )				{ return m_ID; }
+	string GetName( )				{ return m_Name; }
+	uint32_t GetAccess( )			{ return m_Access; }
+	CHistogram *GetTime( )			{ return m_Time; }
+};
+
+//
+// CCommandTable
+//
+
+// the commands understood in one place (in game, on battle.net, in the admin game) keyed by every name they answer to
+// commands are registered once at startup so looking up a command is a single hash probe instead of comparing it against every command name
+
+class CCommandTable
+{
+private:
+	string m_Name;
+	vector<CCommand *> m_Commands;
+	boost::unordered_map<string, CCommand *> m_Names;
+
+public:
+	CCommandTable( string nName );
+	~CCommandTable( );
+
+	string GetName( )					{ return m_Name; }
+	vector<CCommand *> GetCommands( )	{ return m_Commands; }
+
+	void Register( uint32_t id, uint32_t access, string names );	// names is a space separated list, the first one is the command's name and the rest are aliases
+	CCommand *Find( const string &name );							// name must already be lower case
+};
+
+//
+// CCommandScope
+//
+
+// times a command from the moment it's looked up until the dispatcher returns
+
+class CCommandScope
+{
+private:
+	CCommand *m_Command;
+	uint32_t m_StartTicks;
+
+public:
+	CCommandScope( CCommand *nCommand );
+	~CCommandScope( );
+};
+
+#endif
@@ -0,0 +1,213 @@
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#include "ghost.h"
+#include "util.h"
+#include "socket.h"
+#include "metrics.h"
+#include "game_base.h"
+#include "gamethread.h"
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
+//
+// CGameThread
+//
+
+CGameThread :: CGameThread( CGHost *nGHost, CBaseGame *nGame, CSocketPoller *nSocketPoller )
+{
+	m_GHost = nGHost;
+	m_Game = nGame;
+	m_SocketPoller = nSocketPoller;
+	m_Thread = NULL;
+	m_MessagesMutex = new boost :: mutex( );
+	m_Stopping = false;
+	m_Finished = false;
+
+	try
+	{
+		m_Thread = new boost :: thread( boost :: bind( &CGameThread :: Run, this ) );
+	}
+	catch( const boost :: thread_resource_error &tre )
+	{
+		CONSOLE_Print( "[GAMETHREAD: " + m_Game->GetGameName( ) + "] error creating thread - " + string( tre.what( ) ) );
+	}
+}
+
+CGameThread :: ~CGameThread( )
+{
+	Stop( );
+	delete m_MessagesMutex;
+	delete m_SocketPoller;
+}
+
+bool CGameThread :: IsCurrent( )
+{
+	return m_Thread && m_Thread->get_id( ) == boost :: this_thread :: get_id( );
+}
+
+void CGameThread :: Post( const CGameMessage &message )
+{
+	boost :: mutex :: scoped_lock Lock( *m_MessagesMutex );
+	m_Messages.push_back( message );
+}
+
+void CGameThread :: Stop( )
+{
+	if( !m_Thread )
+		return;
+
+	m_Stopping = true;
+	m_Thread->join( );
+	delete m_Thread;
+	m_Thread = NULL;
+
+	// the thread removed the game's sockets from its socket poller before exiting, add them to ours
+
+	m_Game->PollSockets( );
+	RunMessages( );
+}
+
+void CGameThread :: Run( )
+{
+	// the game's sockets were removed from the main thread's socket poller before we started
+
+	SetThreadSocketPoller( m_SocketPoller );
+	m_Game->PollSockets( );
+
+#ifdef GHOST_TIMERFD
+	CActionTimer *ActionTimer = NULL;
+
+	if( m_GHost->m_ActionTimer )
+	{
+		ActionTimer = new CActionTimer( );
+
+		if( ActionTimer->HasError( ) )
+		{
+			delete ActionTimer;
+			ActionTimer = NULL;
+		}
+	}
+#endif
+
+	while( !m_Stopping )
+	{
+		// this is the same as waiting in CGHost :: Update except we only have one game to take care of
+
+		long usecBlock = 50000;
+		uint32_t NextTimedActionTicks = m_Game->GetNextTimedActionTicks( );
+
+#ifdef GHOST_TIMERFD
+		if( ActionTimer )
+			ActionTimer->Arm( GetTicks( ) + NextTimedActionTicks );
+		else
+#endif
+		if( NextTimedActionTicks * 1000 < usecBlock )
+			usecBlock = NextTimedActionTicks * 1000;
+
+		if( usecBlock < 1000 )
+			usecBlock = 1000;
+
+		fd_set fd;
+		fd_set send_fd;
+		fd_set *pfd = &fd;
+		fd_set *psend_fd = &send_fd;
+
+		if( m_SocketPoller )
+		{
+			m_SocketPoller->Wait( usecBlock );
+			pfd = NULL;
+			psend_fd = NULL;
+		}
+		else
+		{
+			int nfds = 0;
+			FD_ZERO( &fd );
+			FD_ZERO( &send_fd );
+			unsigned int NumFDs = m_Game->SetFD( &fd, &send_fd, &nfds );
+
+#ifdef GHOST_TIMERFD
+			if( ActionTimer )
+				ActionTimer->SetFD( &fd, &send_fd, &nfds );
+#endif
+
+			struct timeval tv;
+			tv.tv_sec = 0;
+			tv.tv_usec = usecBlock;
+
+			struct timeval send_tv;
+			send_tv.tv_sec = 0;
+			send_tv.tv_usec = 0;
+
+#ifdef WIN32
+			select( 1, &fd, NULL, NULL, &tv );
+			select( 1, NULL, &send_fd, NULL, &send_tv );
+#else
+			select( nfds + 1, &fd, NULL, NULL, &tv );
+			select( nfds + 1, NULL, &send_fd, NULL, &send_tv );
+#endif
+
+			if( NumFDs == 0 )
+				MILLISLEEP( usecBlock / 1000 );
+		}
+
+#ifdef GHOST_TIMERFD
+		if( ActionTimer )
+			ActionTimer->Check( pfd );
+#endif
+
+		// send the due action packet before waiting for m_Mutex so it goes out on time even if another thread is holding it
+		// the plugin hooks and metrics for it have to wait for m_Mutex, Update calls SendActionsPost for them
+
+		m_Game->SendDueActions( psend_fd );
+
+		boost :: mutex :: scoped_lock Lock( *m_GHost->m_Mutex );
+		RunMessages( );
+		uint32_t GameMicroTicks = GetMicroTicks( );
+
+		if( m_Game->Update( pfd, psend_fd ) )
+			break;
+
+		m_Game->UpdatePost( psend_fd );
+		m_Game->GetMetrics( )->m_UpdateTime.Add( GetMicroTicks( ) - GameMicroTicks );
+	}
+
+#ifdef GHOST_TIMERFD
+	delete ActionTimer;
+#endif
+
+	m_Game->UnpollSockets( );
+	SetThreadSocketPoller( NULL );
+	m_Finished = true;
+}
+
+void CGameThread :: RunMessages( )
+{
+	vector<CGameMessage> Messages;
+
+	{
+		boost :: mutex :: scoped_lock Lock( *m_MessagesMutex );
+		Messages.swap( m_Messages );
+	}
+
+	for( vector<CGameMessage> :: iterator i = Messages.begin( ); i != Messages.end( ); i++ )
+		(*i)( );
+}
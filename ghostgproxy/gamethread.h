@@ -0,0 +1,71 @@
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#ifndef GAMETHREAD_H
+#define GAMETHREAD_H
+
+#include <boost/function.hpp>
+
+namespace boost { class thread; class mutex; }
+
+//
+// CGameThread
+//
+
+// runs a game in progress on its own thread so its action packets go out on time no matter what the rest of the bot is doing
+// the thread waits on the game's sockets with its own socket poller and sends due action packets without holding any locks
+// everything else the game does (player packets, commands, callables, battle.net messages) happens while holding CGHost :: m_Mutex
+// so the game uses the rest of the bot exactly like a game on the main thread does, the main thread only releases m_Mutex while waiting on its sockets
+// since sending action packets doesn't hold m_Mutex other threads mustn't change the game directly, they post a message instead (see CBaseGame :: QueueAllChat)
+
+typedef boost::function<void( )> CGameMessage;
+
+class CGameThread
+{
+private:
+	CGHost *m_GHost;
+	CBaseGame *m_Game;
+	CSocketPoller *m_SocketPoller;		// waits on the game's sockets, NULL when using select
+	boost::thread *m_Thread;
+	boost::mutex *m_MessagesMutex;		// protects m_Messages
+	vector<CGameMessage> m_Messages;	// messages from other threads waiting to be run on this thread
+	volatile bool m_Stopping;			// the bot is exiting, stop updating the game
+	volatile bool m_Finished;			// the thread is done with the game, the main thread has to call Stop before deleting it
+
+public:
+	CGameThread( CGHost *nGHost, CBaseGame *nGame, CSocketPoller *nSocketPoller );
+	~CGameThread( );
+
+	bool GetFinished( )			{ return m_Finished; }
+	bool GetRunning( )			{ return m_Thread != NULL; }
+	bool IsCurrent( );
+	void Post( const CGameMessage &message );
+
+	// waits for the thread to exit and hands the game back to the calling thread, running any messages that were still waiting
+	// this must not be called while holding CGHost :: m_Mutex unless the thread already finished
+
+	void Stop( );
+
+private:
+	void Run( );
+	void RunMessages( );
+};
+
+#endif
@@ -27,6 +27,8 @@
 // CGHost
 //
 
+class CSocketPoller;
+class CActionTimer;
 class CUDPSocket;
 class CTCPServer;
 class CTCPSocket;
@@ -37,20 +39,31 @@ class CBNET;
 class CBaseGame;
 class CAdminGame;
 class CGHostDB;
+class CIPToCountry;
+class CIPBlackList;
+class CIPBlackListLoad;
+class CHistogram;
+class CMetricsServer;
+class CCommandTable;
 class CBaseCallable;
 class CLanguage;
 class CMap;
+class CMapLoad;
 class CSaveGame;
 class CConfig;
 class CCallableCountrySkipList;
 class CCallableVouchList;
 class CPluginMgr;
 
+namespace boost { class mutex; }
+
 typedef pair<string, string> VouchPair;
 
 class CGHost
 {
 public:
+	CSocketPoller *m_SocketPoller;			// waits on all our sockets (NULL when using the giant select statement instead)
+	CActionTimer *m_ActionTimer;			// wakes us up when the next action packet is due (NULL unless bot_actiontimer is enabled, Linux only)
 	CUDPSocket *m_UDPSocket;				// a UDP socket for sending broadcasts and other junk (used with !sendlan)
 	CTCPServer *m_ReconnectSocket;			// listening socket for GProxy++ reliable reconnects
 	vector<CTCPSocket *> m_ReconnectSockets;// vector of sockets attempting to reconnect (connected but not identified yet)
@@ -61,9 +74,26 @@ public:
 	CBaseGame *m_CurrentGame;				// this game is still in the lobby state
 	CAdminGame *m_AdminGame;				// this "fake game" allows an admin who knows the password to control the bot from the local network
 	vector<CBaseGame *> m_Games;			// these games are in progress
+	bool m_GameThreads;						// config value: run each game in progress on its own thread (see gamethread.h)
+	boost::mutex *m_Mutex;					// protects everything shared with the game threads, the main thread holds it except while waiting on its sockets
 	CGHostDB *m_DB;							// database
 	CGHostDB *m_DBLocal;					// local database (for temporary data)
-	vector<CBaseCallable *> m_Callables;	// vector of orphaned callables waiting to die
+	CIPToCountry *m_IPToCountry;			// iptocountry data
+	boost::shared_ptr<CIPBlackList> m_IPBlackList;	// the IP blacklist, never modified but replaced as a whole when the file changes
+	CIPBlackListLoad *m_IPBlackListLoad;	// the IP blacklist being loaded in the background after the file changed
+	uint32_t m_IPBlackListCheckTime;		// GetTime when we last checked if the IP blacklist file changed
+	uint32_t m_IPBlackListFileTime;			// modification time of the IP blacklist file when we last loaded it
+	uint32_t m_IPBlackListFileSize;			// size of the IP blacklist file when we last loaded it
+	vector<CBaseCallable *> m_Callables;	// vector of orphaned callables waiting to die (this is emptied into m_OrphanedCallables each loop)
+	set<CBaseCallable *> m_OrphanedCallables;	// set of orphaned callables which weren't ready yet when they were moved out of m_Callables
+	vector<CMapLoad *> m_MapLoads;			// vector of maps being loaded in the background, in the order they were requested
+	CMetricsServer *m_MetricsServer;		// serves the metrics over HTTP, NULL if bot_metricsport is 0
+	CHistogram *m_UpdateTime;				// microseconds spent in each loop not counting waiting for sockets
+	CHistogram *m_CallableLatency;			// milliseconds from queueing a callable until the main thread drained it
+	CHistogram *m_CallableRunTime;			// milliseconds a worker thread spent running a callable
+	CCommandTable *m_GameCommands;			// the commands players can use in a game
+	CCommandTable *m_AdminGameCommands;		// the commands players can use in the admin game
+	CCommandTable *m_BNETCommands;			// the commands users can use on battle.net
 	vector<BYTEARRAY> m_LocalAddresses;		// vector of local IP addresses
 	CLanguage *m_Language;					// language
 	CMap *m_Map;							// the currently loaded map
@@ -101,6 +131,8 @@ public:
 	string m_MapCFGPath;					// config value: map cfg path
 	string m_SaveGamePath;					// config value: savegame path
 	string m_MapPath;						// config value: map path
+	bool m_MapMemoryMapped;					// config value: memory map map files instead of reading them into memory
+	string m_MapCachePath;					// config value: map cache path
 	bool m_SaveReplays;						// config value: save replays
 	string m_ReplayPath;					// config value: replay path
 	string m_VirtualHostName;				// config value: virtual host name
@@ -209,6 +241,7 @@ public:
 
 	void ReloadConfigs( );
 	void ReloadMap( );
+	void LoadMap( CConfig *MapCFG, string CFGFile, boost::function<void ( CMap * )> callback );
 	void SetConfigs( CConfig *CFG );
 	void ExtractScripts( );
 	void LoadIPToCountryData( );
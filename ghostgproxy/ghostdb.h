@@ -1,1155 +1,1215 @@
-/*
-
-   Copyright [2008] [Trevor Hogan]
-
-   Licensed under the Apache License, Version 2.0 (the "License");
-   you may not use this file except in compliance with the License.
-   You may obtain a copy of the License at
-
-       http://www.apache.org/licenses/LICENSE-2.0
-
-   Unless required by applicable law or agreed to in writing, software
-   distributed under the License is distributed on an "AS IS" BASIS,
-   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-   See the License for the specific language governing permissions and
-   limitations under the License.
-
-   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
-
-*/
-
-#ifndef GHOSTDB_H
-#define GHOSTDB_H
-
-#define GI_NEW_GAME 0
-#define GI_STARTUP 200
-#define GI_CLEANUP 210
-#define GI_ACTIVATE_GAME 220
-#define GI_DELETE_GAME 255
-
-
-//
-// CGHostDB
-//
-
-class CBaseCallable;
-class CCallableAdminCount;
-class CCallableAdminCheck;
-class CCallableAdminAdd;
-class CCallableAdminRemove;
-class CCallableAdminList;
-class CCallableBanCount;
-class CCallableBanCheck;
-class CCallableBanAdd;
-class CCallableBanRemove;
-class CCallableBanList;
-class CCallableGameAdd;
-class CCallableGamePlayerAdd;
-class CCallableGamePlayerSummaryCheck;
-class CCallableDotAGameAdd;
-class CCallableDotAPlayerAdd;
-class CCallableDotAPlayerSummaryCheck;
-class CCallableDownloadAdd;
-class CCallableScoreCheck;
-class CCallableW3MMDPlayerAdd;
-class CCallableW3MMDVarAdd;
-class CDBBan;
-class CDBGame;
-class CDBGamePlayer;
-class CDBGamePlayerSummary;
-class CDBDotAPlayerSummary;
-
-
-// nordicleague 
-class CDBLastSeenPlayer;
-class CCallableLastSeenPlayer;
-class CCallableRegisterPlayerAdd;
-class CCallableDotAEventAdd;
-class CCallableUpdateGameInfo;
-class CCallableSeenPlayer;
-class CCallableSaveReplay;
-class CCallableCountrySkipList;
-class CCallableVouchList;
-
-class CPacked;
-class CReplay;
-
-typedef pair<uint32_t,string> VarP;
-
-class CGHostDB
-{
-protected:
-	bool m_HasError;
-	string m_Error;
-
-public:
-	CGHostDB( CConfig *CFG );
-	virtual ~CGHostDB( );
-
-	bool HasError( )			{ return m_HasError; }
-	string GetError( )			{ return m_Error; }
-	virtual string GetStatus( )	{ return "DB STATUS --- OK"; }
-
-	virtual void RecoverCallable( CBaseCallable *callable );
-
-	// standard (non-threaded) database functions
-
-	virtual bool Begin( );
-	virtual bool Commit( );
-	virtual uint32_t AdminCount( string server );
-	virtual bool AdminCheck( string server, string user );
-	virtual bool AdminAdd( string server, string user );
-	virtual bool AdminRemove( string server, string user );
-	virtual vector<string> AdminList( string server );
-	virtual uint32_t BanCount( string server );
-	virtual CDBBan *BanCheck( string server, string user, string ip );
-	virtual bool BanAdd( string server, string user, string ip, string gamename, string admin, string reason, uint32_t bantime = 0, uint32_t ipban = 0 );
-	virtual bool BanRemove( string server, string user, string admin, string reason = "" );
-	virtual bool BanRemove( string user, string admin, string reason = "" );
-	virtual vector<CDBBan *> BanList( string server );
-	virtual uint32_t GameAdd( string server, string map, string gamename, string ownername, uint32_t duration, uint32_t gamestate, string creatorname, string creatorserver );
-	virtual uint32_t GamePlayerAdd( uint32_t gameid, string name, string ip, uint32_t spoofed, string spoofedrealm, uint32_t reserved, uint32_t loadingtime, uint32_t left, string leftreason, uint32_t team, uint32_t colour );
-	virtual uint32_t GamePlayerCount( string name );
-	virtual CDBGamePlayerSummary *GamePlayerSummaryCheck( string name );
-	virtual uint32_t DotAGameAdd( uint32_t gameid, uint32_t winner, uint32_t min, uint32_t sec );
-	virtual uint32_t DotAPlayerAdd( uint32_t gameid, string name, uint32_t colour, uint32_t kills, uint32_t deaths, uint32_t creepkills, uint32_t creepdenies, uint32_t assists, uint32_t gold, uint32_t neutralkills, string item1, string item2, string item3, string item4, string item5, string item6, string hero, uint32_t newcolour, uint32_t towerkills, uint32_t raxkills, uint32_t courierkills, uint32_t outcome, uint32_t level, uint32_t apm );
-	virtual uint32_t DotAPlayerCount( string name );
-	virtual CDBDotAPlayerSummary *DotAPlayerSummaryCheck( string name );
-	virtual string FromCheck( uint32_t ip );
-	virtual bool FromAdd( uint32_t ip1, uint32_t ip2, string country );
-	virtual bool DownloadAdd( string map, uint32_t mapsize, string name, string ip, uint32_t spoofed, string spoofedrealm, uint32_t downloadtime );
-	virtual uint32_t W3MMDPlayerAdd( string category, uint32_t gameid, uint32_t pid, string name, string flag, uint32_t leaver, uint32_t practicing );
-	virtual bool W3MMDVarAdd( uint32_t gameid, map<VarP,int32_t> var_ints );
-	virtual bool W3MMDVarAdd( uint32_t gameid, map<VarP,double> var_reals );
-	virtual bool W3MMDVarAdd( uint32_t gameid, map<VarP,string> var_strings );
-	
-	
-	// nordicleague
-	
-	virtual uint32_t 					RegisterPlayerAdd( string name, string email, string ip );
-	virtual CCallableRegisterPlayerAdd 	*ThreadedRegisterPlayerAdd( string name, string email, string ip );
-	
-	virtual uint32_t 					DotAEventAdd( uint32_t gameid, string gamename, string killer, string victim, uint32_t kcolour, uint32_t vcolour );
-	virtual CCallableDotAEventAdd 		*ThreadedDotAEventAdd( uint32_t gameid, string gamename, string Killer, string Victim, uint32_t kcolour, uint32_t vcolour );
-	
-	// Keep track of current games in database for channel/website info
-	
-	virtual bool 						UpdateGameInfo( string name, uint32_t players, bool ispublic, vector<string> m_Slots);
-	virtual CCallableUpdateGameInfo 	*ThreadedUpdateGameInfo( string name, uint32_t players, bool ispublic, vector<string> m_Slots );
-	
-	virtual CDBLastSeenPlayer			*LastSeenPlayer( string name );
-	virtual CCallableLastSeenPlayer 	*ThreadedLastSeenPlayer( string name );
-	
-	virtual bool 						SaveReplay( CReplay *replay );
-	virtual CCallableSaveReplay 		*ThreadedSaveReplay( CReplay *replay );
-	
-	virtual set<string> 				CountrySkipList( );
-	virtual CCallableCountrySkipList 	*ThreadedCountrySkipList( );
-
-	virtual set<VouchPair> 				VouchList( );
-	virtual CCallableVouchList			*ThreadedVouchList( );
-
-	// threaded database functions
-
-	virtual void CreateThread( CBaseCallable *callable );
-	virtual CCallableAdminCount *ThreadedAdminCount( string server );
-	virtual CCallableAdminCheck *ThreadedAdminCheck( string server, string user );
-	virtual CCallableAdminAdd *ThreadedAdminAdd( string server, string user );
-	virtual CCallableAdminRemove *ThreadedAdminRemove( string server, string user );
-	virtual CCallableAdminList *ThreadedAdminList( string server );
-	virtual CCallableBanCount *ThreadedBanCount( string server );
-	virtual CCallableBanCheck *ThreadedBanCheck( string server, string user, string ip );
-	virtual CCallableBanAdd *ThreadedBanAdd( string server, string user, string ip, string gamename, string admin, string reason, uint32_t bantime = 0, uint32_t ipban = 0 );
-	virtual CCallableBanRemove *ThreadedBanRemove( string server, string user, string admin, string reason );
-	virtual CCallableBanRemove *ThreadedBanRemove( string user, string admin, string reason = "" );
-	virtual CCallableBanList *ThreadedBanList( string server );
-	virtual CCallableGameAdd *ThreadedGameAdd( string server, string map, string gamename, string ownername, uint32_t duration, uint32_t gamestate, string creatorname, string creatorserver, vector<string> chatlog );
-	virtual CCallableGamePlayerAdd *ThreadedGamePlayerAdd( uint32_t gameid, string name, string ip, uint32_t spoofed, string spoofedrealm, uint32_t reserved, uint32_t loadingtime, uint32_t left, string leftreason, uint32_t team, uint32_t colour );
-	virtual CCallableGamePlayerSummaryCheck *ThreadedGamePlayerSummaryCheck( string name, uint32_t season = 2 );
-	virtual CCallableDotAGameAdd *ThreadedDotAGameAdd( uint32_t gameid, uint32_t winner, uint32_t min, uint32_t sec );
-	virtual CCallableDotAPlayerAdd *ThreadedDotAPlayerAdd( uint32_t gameid, string name, uint32_t colour, uint32_t kills, uint32_t deaths, uint32_t creepkills, uint32_t creepdenies, uint32_t assists, uint32_t gold, uint32_t neutralkills, string item1, string item2, string item3, string item4, string item5, string item6, string hero, uint32_t newcolour, uint32_t towerkills, uint32_t raxkills, uint32_t courierkills, uint32_t outcome, uint32_t level, uint32_t apm );
-	virtual CCallableDotAPlayerSummaryCheck *ThreadedDotAPlayerSummaryCheck( string name, uint32_t season = 2);
-	virtual CCallableDownloadAdd *ThreadedDownloadAdd( string map, uint32_t mapsize, string name, string ip, uint32_t spoofed, string spoofedrealm, uint32_t downloadtime );
-	virtual CCallableScoreCheck *ThreadedScoreCheck( string category, string name, string server, uint32_t season = 2 );
-	virtual CCallableW3MMDPlayerAdd *ThreadedW3MMDPlayerAdd( string category, uint32_t gameid, uint32_t pid, string name, string flag, uint32_t leaver, uint32_t practicing );
-	virtual CCallableW3MMDVarAdd *ThreadedW3MMDVarAdd( uint32_t gameid, map<VarP,int32_t> var_ints );
-	virtual CCallableW3MMDVarAdd *ThreadedW3MMDVarAdd( uint32_t gameid, map<VarP,double> var_reals );
-	virtual CCallableW3MMDVarAdd *ThreadedW3MMDVarAdd( uint32_t gameid, map<VarP,string> var_strings );
-};
-
-//
-// Callables
-//
-
-// life cycle of a callable:
-//  - the callable is created in one of the database's ThreadedXXX functions
-//  - initially the callable is NOT ready (i.e. m_Ready = false)
-//  - the ThreadedXXX function normally creates a thread to perform some query and (potentially) store some result in the callable
-//  - at the time of this writing all threads are immediately detached, the code does not join any threads (the callable's "readiness" is used for this purpose instead)
-//  - when the thread completes it will set m_Ready = true
-//  - DO NOT DO *ANYTHING* TO THE CALLABLE UNTIL IT'S READY OR YOU WILL CREATE A CONCURRENCY MESS
-//  - THE ONLY SAFE FUNCTION IN THE CALLABLE IS GetReady
-//  - when the callable is ready you may access the callable's result which will have been set within the (now terminated) thread
-
-// example usage:
-//  - normally you will call a ThreadedXXX function, store the callable in a vector, and periodically check if the callable is ready
-//  - when the callable is ready you will consume the result then you will pass the callable back to the database via the RecoverCallable function
-//  - the RecoverCallable function allows the database to recover some of the callable's resources to be reused later (e.g. MySQL connections)
-//  - note that this will NOT free the callable's memory, you must do that yourself after calling the RecoverCallable function
-//  - be careful not to leak any callables, it's NOT safe to delete a callable even if you decide that you don't want the result anymore
-//  - you should deliver any to-be-orphaned callables to the main vector in CGHost so they can be properly deleted when ready even if you don't care about the result anymore
-//  - e.g. if a player does a stats check immediately before a game is deleted you can't just delete the callable on game deletion unless it's ready
-
-class CBaseCallable
-{
-protected:
-	string m_Error;
-	volatile bool m_Ready;
-	uint32_t m_StartTicks;
-	uint32_t m_EndTicks;
-
-public:
-	CBaseCallable( ) : m_Error( ), m_Ready( false ), m_StartTicks( 0 ), m_EndTicks( 0 ) { }
-	virtual ~CBaseCallable( ) { }
-
-	virtual void operator( )( ) { }
-
-	virtual void Init( );
-	virtual void Close( );
-
-	virtual string GetError( )				{ return m_Error; }
-	virtual bool GetReady( )				{ return m_Ready; }
-	virtual void SetReady( bool nReady )	{ m_Ready = nReady; }
-	virtual uint32_t GetElapsed( )			{ return m_Ready ? m_EndTicks - m_StartTicks : 0; }
-};
-
-class CCallableAdminCount : virtual public CBaseCallable
-{
-protected:
-	string m_Server;
-	uint32_t m_Result;
-
-public:
-	CCallableAdminCount( string nServer ) : CBaseCallable( ), m_Server( nServer ), m_Result( 0 ) { }
-	virtual ~CCallableAdminCount( );
-
-	virtual string GetServer( )					{ return m_Server; }
-	virtual uint32_t GetResult( )				{ return m_Result; }
-	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
-};
-
-class CCallableAdminCheck : virtual public CBaseCallable
-{
-protected:
-	string m_Server;
-	string m_User;
-	bool m_Result;
-
-public:
-	CCallableAdminCheck( string nServer, string nUser ) : CBaseCallable( ), m_Server( nServer ), m_User( nUser ), m_Result( false ) { }
-	virtual ~CCallableAdminCheck( );
-
-	virtual string GetServer( )				{ return m_Server; }
-	virtual string GetUser( )				{ return m_User; }
-	virtual bool GetResult( )				{ return m_Result; }
-	virtual void SetResult( bool nResult )	{ m_Result = nResult; }
-};
-
-class CCallableAdminAdd : virtual public CBaseCallable
-{
-protected:
-	string m_Server;
-	string m_User;
-	bool m_Result;
-
-public:
-	CCallableAdminAdd( string nServer, string nUser ) : CBaseCallable( ), m_Server( nServer ), m_User( nUser ), m_Result( false ) { }
-	virtual ~CCallableAdminAdd( );
-
-	virtual string GetServer( )				{ return m_Server; }
-	virtual string GetUser( )				{ return m_User; }
-	virtual bool GetResult( )				{ return m_Result; }
-	virtual void SetResult( bool nResult )	{ m_Result = nResult; }
-};
-
-class CCallableAdminRemove : virtual public CBaseCallable
-{
-protected:
-	string m_Server;
-	string m_User;
-	bool m_Result;
-
-public:
-	CCallableAdminRemove( string nServer, string nUser ) : CBaseCallable( ), m_Server( nServer ), m_User( nUser ), m_Result( false ) { }
-	virtual ~CCallableAdminRemove( );
-
-	virtual string GetServer( )				{ return m_Server; }
-	virtual string GetUser( )				{ return m_User; }
-	virtual bool GetResult( )				{ return m_Result; }
-	virtual void SetResult( bool nResult )	{ m_Result = nResult; }
-};
-
-class CCallableAdminList : virtual public CBaseCallable
-{
-protected:
-	string m_Server;
-	vector<string> m_Result;
-
-public:
-	CCallableAdminList( string nServer ) : CBaseCallable( ), m_Server( nServer ) { }
-	virtual ~CCallableAdminList( );
-
-	virtual vector<string> GetResult( )					{ return m_Result; }
-	virtual void SetResult( vector<string> nResult )	{ m_Result = nResult; }
-};
-
-class CCallableBanCount : virtual public CBaseCallable
-{
-protected:
-	string m_Server;
-	uint32_t m_Result;
-
-public:
-	CCallableBanCount( string nServer ) : CBaseCallable( ), m_Server( nServer ), m_Result( 0 ) { }
-	virtual ~CCallableBanCount( );
-
-	virtual string GetServer( )					{ return m_Server; }
-	virtual uint32_t GetResult( )				{ return m_Result; }
-	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
-};
-
-class CCallableBanCheck : virtual public CBaseCallable
-{
-protected:
-	string m_Server;
-	string m_User;
-	string m_IP;
-	CDBBan *m_Result;
-
-public:
-	CCallableBanCheck( string nServer, string nUser, string nIP ) : CBaseCallable( ), m_Server( nServer ), m_User( nUser ), m_IP( nIP ), m_Result( NULL ) { }
-	virtual ~CCallableBanCheck( );
-
-	virtual string GetServer( )					{ return m_Server; }
-	virtual string GetUser( )					{ return m_User; }
-	virtual string GetIP( )						{ return m_IP; }
-	virtual CDBBan *GetResult( )				{ return m_Result; }
-	virtual void SetResult( CDBBan *nResult )	{ m_Result = nResult; }
-};
-
-class CCallableBanAdd : virtual public CBaseCallable
-{
-protected:
-	string m_Server;
-	string m_User;
-	string m_IP;
-	string m_GameName;
-	string m_Admin;
-	string m_Reason;
-	uint32_t m_BanTime;
-	uint32_t m_IPBan;
-	bool m_Result;
-
-public:
-	CCallableBanAdd( string nServer, string nUser, string nIP, string nGameName, string nAdmin, string nReason, uint32_t nBanTime, uint32_t nIPBan ) : CBaseCallable( ), m_Server( nServer ), m_User( nUser ), m_IP( nIP ), m_GameName( nGameName ), m_Admin( nAdmin ), m_Reason( nReason ), m_BanTime( nBanTime), m_IPBan( nIPBan ), m_Result( false ) { }
-	virtual ~CCallableBanAdd( );
-
-	virtual string GetServer( )				{ return m_Server; }
-	virtual string GetUser( )				{ return m_User; }
-	virtual string GetIP( )					{ return m_IP; }
-	virtual string GetGameName( )			{ return m_GameName; }
-	virtual string GetAdmin( )				{ return m_Admin; }
-	virtual string GetReason( )				{ return m_Reason; }
-	virtual uint32_t GetBanTime( )			{ return m_BanTime; }
-	virtual uint32_t GetIPBan( )			{ return m_IPBan; }
-	virtual bool GetResult( )				{ return m_Result; }
-	virtual void SetResult( bool nResult )	{ m_Result = nResult; }
-};
-
-class CCallableBanRemove : virtual public CBaseCallable
-{
-protected:
-	string m_Server;
-	string m_User;
-	string m_Admin;
-	string m_Reason;
-	bool m_Result;
-
-public:
-	CCallableBanRemove( string nServer, string nUser, string nAdmin, string nReason ) : CBaseCallable( ), m_Server( nServer ), m_User( nUser ), m_Admin( nAdmin ), m_Reason( nReason ), m_Result( false ) { }
-	virtual ~CCallableBanRemove( );
-
-	virtual string GetServer( )				{ return m_Server; }
-	virtual string GetUser( )				{ return m_User; }
-	virtual string GetAdmin( )				{ return m_Admin; }
-	virtual string GetReason( )				{ return m_Reason; }
-	virtual bool GetResult( )				{ return m_Result; }
-	virtual void SetResult( bool nResult )	{ m_Result = nResult; }
-};
-
-class CCallableBanList : virtual public CBaseCallable
-{
-protected:
-	string m_Server;
-	vector<CDBBan *> m_Result;
-
-public:
-	CCallableBanList( string nServer ) : CBaseCallable( ), m_Server( nServer ) { }
-	virtual ~CCallableBanList( );
-
-	virtual vector<CDBBan *> GetResult( )				{ return m_Result; }
-	virtual void SetResult( vector<CDBBan *> nResult )	{ m_Result = nResult; }
-};
-
-class CCallableGameAdd : virtual public CBaseCallable
-{
-protected:
-	string m_Server;
-	string m_Map;
-	string m_GameName;
-	string m_OwnerName;
-	uint32_t m_Duration;
-	uint32_t m_GameState;
-	string m_CreatorName;
-	string m_CreatorServer;
-	vector<string> m_ChatLog;
-	uint32_t m_Result;
-
-public:
-	CCallableGameAdd( string nServer, string nMap, string nGameName, string nOwnerName, uint32_t nDuration, uint32_t nGameState, string nCreatorName, string nCreatorServer, vector<string> nChatLog ) : CBaseCallable( ), m_Server( nServer ), m_Map( nMap ), m_GameName( nGameName ), m_OwnerName( nOwnerName ), m_Duration( nDuration ), m_GameState( nGameState ), m_CreatorName( nCreatorName ), m_CreatorServer( nCreatorServer ), m_ChatLog( nChatLog ), m_Result( 0 ) { }
-	virtual ~CCallableGameAdd( );
-
-	virtual uint32_t GetResult( )				{ return m_Result; }
-	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
-};
-
-class CCallableGamePlayerAdd : virtual public CBaseCallable
-{
-protected:
-	uint32_t m_GameID;
-	string m_Name;
-	string m_IP;
-	uint32_t m_Spoofed;
-	string m_SpoofedRealm;
-	uint32_t m_Reserved;
-	uint32_t m_LoadingTime;
-	uint32_t m_Left;
-	string m_LeftReason;
-	uint32_t m_Team;
-	uint32_t m_Colour;
-	uint32_t m_Result;
-
-public:
-	CCallableGamePlayerAdd( uint32_t nGameID, string nName, string nIP, uint32_t nSpoofed, string nSpoofedRealm, uint32_t nReserved, uint32_t nLoadingTime, uint32_t nLeft, string nLeftReason, uint32_t nTeam, uint32_t nColour ) : CBaseCallable( ), m_GameID( nGameID ), m_Name( nName ), m_IP( nIP ), m_Spoofed( nSpoofed ), m_SpoofedRealm( nSpoofedRealm ), m_Reserved( nReserved ), m_LoadingTime( nLoadingTime ), m_Left( nLeft ), m_LeftReason( nLeftReason ), m_Team( nTeam ), m_Colour( nColour ), m_Result( 0 ) { }
-	virtual ~CCallableGamePlayerAdd( );
-
-	virtual uint32_t GetResult( )				{ return m_Result; }
-	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
-};
-
-class CCallableGamePlayerSummaryCheck : virtual public CBaseCallable
-{
-protected:
-	string m_Name;
-	CDBGamePlayerSummary *m_Result;
-	uint32_t m_Season;
-
-public:
-	CCallableGamePlayerSummaryCheck( string nName, uint32_t nSeason ) : CBaseCallable( ), m_Season( nSeason ), m_Name( nName ), m_Result( NULL ) { }
-	virtual ~CCallableGamePlayerSummaryCheck( );
-
-	virtual string GetName( )								{ return m_Name; }
-	virtual string SetName( string nName )					{ m_Name = nName; }
-	virtual CDBGamePlayerSummary *GetResult( )				{ return m_Result; }
-	virtual void SetResult( CDBGamePlayerSummary *nResult )	{ m_Result = nResult; }
-	virtual uint32_t GetSeason()								{ return m_Season; }
-};
-
-class CCallableDotAGameAdd : virtual public CBaseCallable
-{
-protected:
-	uint32_t m_GameID;
-	uint32_t m_Winner;
-	uint32_t m_Min;
-	uint32_t m_Sec;
-	uint32_t m_Result;
-
-public:
-	CCallableDotAGameAdd( uint32_t nGameID, uint32_t nWinner, uint32_t nMin, uint32_t nSec ) : CBaseCallable( ), m_GameID( nGameID ), m_Winner( nWinner ), m_Min( nMin ), m_Sec( nSec ), m_Result( 0 ) { }
-	virtual ~CCallableDotAGameAdd( );
-
-	virtual uint32_t GetResult( )				{ return m_Result; }
-	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
-};
-
-class CCallableDotAEventAdd : virtual public CBaseCallable
-{
-protected:
-	uint32_t m_GameID;
-	string	 m_GameName;
-	string 	 m_Killer;
-	string 	 m_Victim;
-	uint32_t m_Result;
-	uint32_t m_KillerColour;
-	uint32_t m_VictimColour;
-
-public:
-	CCallableDotAEventAdd( uint32_t nGameID, string nGameName, string nKiller, string nVictim, uint32_t kcolour, uint32_t vcolour ) : CBaseCallable( ), m_GameID( nGameID), m_GameName( nGameName ), m_Killer( nKiller ), m_Victim( nVictim ), m_KillerColour( kcolour ), m_VictimColour( vcolour ), m_Result( 0 ) { }
-	virtual ~CCallableDotAEventAdd( );
-
-	virtual uint32_t GetResult( )				{ return m_Result; }
-	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
-};
-
-
-class CCallableDotAPlayerAdd : virtual public CBaseCallable
-{
-protected:
-	uint32_t m_GameID;
-	uint32_t m_Colour;
-	uint32_t m_Kills;
-	uint32_t m_Deaths;
-	uint32_t m_CreepKills;
-	uint32_t m_CreepDenies;
-	uint32_t m_Assists;
-	uint32_t m_Gold;
-	uint32_t m_NeutralKills;
-	string m_Item1;
-	string m_Item2;
-	string m_Item3;
-	string m_Item4;
-	string m_Item5;
-	string m_Item6;
-	string m_Hero;
-	uint32_t m_NewColour;
-	uint32_t m_TowerKills;
-	uint32_t m_RaxKills;
-	uint32_t m_CourierKills;
-	uint32_t m_Result;
-	
-	// nordicleague
-	
-	string 	 m_Name;
-	uint32_t m_Outcome;
-	uint32_t m_Level;
-	uint32_t m_Apm;
-
-public:
-	CCallableDotAPlayerAdd( uint32_t nGameID, string nName, uint32_t nColour, uint32_t nKills, uint32_t nDeaths, uint32_t nCreepKills, uint32_t nCreepDenies, uint32_t nAssists, uint32_t nGold, uint32_t nNeutralKills, string nItem1, string nItem2, string nItem3, string nItem4, string nItem5, string nItem6, string nHero, uint32_t nNewColour, uint32_t nTowerKills, uint32_t nRaxKills, uint32_t nCourierKills, uint32_t nOutcome, uint32_t nLevel, uint32_t nApm ) : CBaseCallable( ), m_GameID( nGameID ), m_Name( nName ), m_Colour( nColour ), m_Kills( nKills ), m_Deaths( nDeaths ), m_CreepKills( nCreepKills ), m_CreepDenies( nCreepDenies ), m_Assists( nAssists ), m_Gold( nGold ), m_NeutralKills( nNeutralKills ), m_Item1( nItem1 ), m_Item2( nItem2 ), m_Item3( nItem3 ), m_Item4( nItem4 ), m_Item5( nItem5 ), m_Item6( nItem6 ), m_Hero( nHero ), m_NewColour( nNewColour ), m_TowerKills( nTowerKills ), m_RaxKills( nRaxKills ), m_CourierKills( nCourierKills ), m_Outcome( nOutcome ), m_Level ( nLevel ), m_Apm ( nApm), m_Result( 0 ) { }
-	virtual ~CCallableDotAPlayerAdd( );
-
-	virtual uint32_t GetResult( )				{ return m_Result; }
-	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
-};
-
-class CCallableDotAPlayerSummaryCheck : virtual public CBaseCallable
-{
-protected:
-	string m_Name;
-	uint32_t m_Season;
-	CDBDotAPlayerSummary *m_Result;
-
-public:
-	CCallableDotAPlayerSummaryCheck( string nName, uint32_t nSeason ) : CBaseCallable( ), m_Name( nName ), m_Season( nSeason ), m_Result( NULL ) { }
-	virtual ~CCallableDotAPlayerSummaryCheck( );
-
-	virtual string GetName( )						{ return m_Name; }
-	virtual string SetName( string nName )					{ m_Name = nName; }
-	virtual CDBDotAPlayerSummary *GetResult( )				{ return m_Result; }
-	virtual void SetResult( CDBDotAPlayerSummary *nResult )			{ m_Result = nResult; }
-	virtual uint32_t GetSeason()								{ return m_Season; }
-};
-
-class CCallableDownloadAdd : virtual public CBaseCallable
-{
-protected:
-	string m_Map;
-	uint32_t m_MapSize;
-	string m_Name;
-	string m_IP;
-	uint32_t m_Spoofed;
-	string m_SpoofedRealm;
-	uint32_t m_DownloadTime;
-	bool m_Result;
-
-public:
-	CCallableDownloadAdd( string nMap, uint32_t nMapSize, string nName, string nIP, uint32_t nSpoofed, string nSpoofedRealm, uint32_t nDownloadTime ) : CBaseCallable( ), m_Map( nMap ), m_MapSize( nMapSize ), m_Name( nName ), m_IP( nIP ), m_Spoofed( nSpoofed ), m_SpoofedRealm( nSpoofedRealm ), m_DownloadTime( nDownloadTime ), m_Result( false ) { }
-	virtual ~CCallableDownloadAdd( );
-
-	virtual bool GetResult( )				{ return m_Result; }
-	virtual void SetResult( bool nResult )	{ m_Result = nResult; }
-};
-
-class CCallableScoreCheck : virtual public CBaseCallable
-{
-protected:
-	string m_Category;
-	string m_Name;
-	string m_Server;
-	double m_Result;
-	uint32_t m_Season;
-	
-	// nordicleague
-	
-	CDBGamePlayerSummary *m_GamePlayer;
-
-public:
-	CCallableScoreCheck( string nCategory, string nName, string nServer, uint32_t nSeason ) : CBaseCallable( ), m_Season( nSeason ), m_Category( nCategory ), m_Name( nName ), m_Server( nServer ), m_Result( 0.0 ), m_GamePlayer( NULL ) { }
-	virtual ~CCallableScoreCheck( );
-
-	virtual string GetName( )										{ return m_Name; }
-	virtual double GetResult( )										{ return m_Result; }
-	virtual void SetResult( double nResult )						{ m_Result = nResult; }
-	virtual uint32_t GetSeason()									{ return m_Season; }
-	
-	// nordicleague
-	
-	virtual CDBGamePlayerSummary *GetPlayerSummary( )				{ return m_GamePlayer; }
-	virtual void SetPlayerSummary( CDBGamePlayerSummary *nSummary )	{ m_GamePlayer = nSummary; }
-};
-
-class CCallableW3MMDPlayerAdd : virtual public CBaseCallable
-{
-protected:
-	string m_Category;
-	uint32_t m_GameID;
-	uint32_t m_PID;
-	string m_Name;
-	string m_Flag;
-	uint32_t m_Leaver;
-	uint32_t m_Practicing;
-	uint32_t m_Result;
-
-public:
-	CCallableW3MMDPlayerAdd( string nCategory, uint32_t nGameID, uint32_t nPID, string nName, string nFlag, uint32_t nLeaver, uint32_t nPracticing ) : CBaseCallable( ), m_Category( nCategory ), m_GameID( nGameID ), m_PID( nPID ), m_Name( nName ), m_Flag( nFlag ), m_Leaver( nLeaver ), m_Practicing( nPracticing ), m_Result( 0 ) { }
-	virtual ~CCallableW3MMDPlayerAdd( );
-
-	virtual uint32_t GetResult( )				{ return m_Result; }
-	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
-};
-
-class CCallableW3MMDVarAdd : virtual public CBaseCallable
-{
-protected:
-	uint32_t m_GameID;
-	map<VarP,int32_t> m_VarInts;
-	map<VarP,double> m_VarReals;
-	map<VarP,string> m_VarStrings;
-
-	enum ValueType {
-		VALUETYPE_INT = 1,
-		VALUETYPE_REAL = 2,
-		VALUETYPE_STRING = 3
-	};
-
-	ValueType m_ValueType;
-	bool m_Result;
-
-public:
-	CCallableW3MMDVarAdd( uint32_t nGameID, map<VarP,int32_t> nVarInts ) : CBaseCallable( ), m_GameID( nGameID ), m_VarInts( nVarInts ), m_ValueType( VALUETYPE_INT ), m_Result( false ) { }
-	CCallableW3MMDVarAdd( uint32_t nGameID, map<VarP,double> nVarReals ) : CBaseCallable( ), m_GameID( nGameID ), m_VarReals( nVarReals ), m_ValueType( VALUETYPE_REAL ), m_Result( false ) { }
-	CCallableW3MMDVarAdd( uint32_t nGameID, map<VarP,string> nVarStrings ) : CBaseCallable( ), m_GameID( nGameID ), m_VarStrings( nVarStrings ), m_ValueType( VALUETYPE_STRING ), m_Result( false ) { }
-	virtual ~CCallableW3MMDVarAdd( );
-
-	virtual bool GetResult( )				{ return m_Result; }
-	virtual void SetResult( bool nResult )	{ m_Result = nResult; }
-};
-
-// nordicleague
-
-class CCallableUpdateGameInfo : virtual public CBaseCallable
-{
-protected:
-	string m_Name;
-	uint32_t m_Players;
-	bool m_Public;
-	bool m_Result;
-	vector<string> m_Slots;
-
-public:
-	CCallableUpdateGameInfo( string name, uint32_t players, bool ispublic, vector<string> slots ) : CBaseCallable( ), m_Name( name ), m_Players( players ), m_Public( ispublic ), m_Slots( slots ),  m_Result( false ) { }
-	virtual ~CCallableUpdateGameInfo( );
-
-	virtual bool GetResult( )					{ return m_Result; }
-	virtual void SetResult( bool nResult )		{ m_Result = nResult; }
-	virtual void SetName( string name ) 		{ m_Name = name; }
-	virtual void SetPlayers( uint32_t players ) { m_Players = players; }
-	virtual void SetPublic( bool ispublic ) 	{ m_Public = ispublic; }
-};
-
-class CCallableCountrySkipList : virtual public CBaseCallable
-{
-protected:
-	set<string> m_Result;
-
-public:
-	CCallableCountrySkipList( ) : CBaseCallable( ) { }
-	virtual ~CCallableCountrySkipList( );
-
-	virtual set<string> GetResult( )					{ return m_Result; }
-	virtual void SetResult( set<string> nResult )	{ m_Result = nResult; }
-};
-
-class CCallableVouchList : virtual public CBaseCallable
-{
-protected:
-	set<VouchPair> m_Result;
-
-public:
-	CCallableVouchList( ) : CBaseCallable( ) { }
-	virtual ~CCallableVouchList( );
-
-	virtual set<VouchPair> GetResult( )					{ return m_Result; }
-	virtual void SetResult( set<VouchPair> nResult )	{ m_Result = nResult; }
-};
-
-//
-// CDBBan
-//
-
-class CDBBan
-{
-private:
-	string m_Server;
-	string m_Name;
-	string m_IP;
-	string m_Date;
-	string m_GameName;
-	string m_Admin;
-	string m_Reason;
-	
-	// nordicleague
-	
-	bool m_IPBan;
-	string m_Expires;
-
-public:
-	CDBBan( string nServer, string nName, string nIP, string nDate, string nGameName, string nAdmin, string nReason );
-	
-	// nordicleague
-	
-	CDBBan( string nServer, string nName, string nIP, string nDate, string nGameName, string nAdmin, string nReason, string nExpires );
-	CDBBan( string nServer, string nName, string nIP, string nDate, string nGameName, string nAdmin, string nReason, uint32_t nIPBan );
-	CDBBan( string nServer, string nName, string nIP, string nDate, string nGameName, string nAdmin, string nReason, uint32_t nIPBan, string nExpires );
-	~CDBBan( );
-
-	string GetServer( )		{ return m_Server; }
-	string GetName( )		{ return m_Name; }
-	string GetIP( )			{ return m_IP; }
-	string GetDate( )		{ return m_Date; }
-	string GetGameName( )	{ return m_GameName; }
-	string GetAdmin( )		{ return m_Admin; }
-	string GetReason( )		{ return m_Reason; }
-	
-	// nordicleague
-	
-	bool   GetIPBan( )		{ return m_IPBan; }
-	bool   IsTemporary()	{ return m_Expires.empty() ? false : true; }
-	string GetExpires()		{ return m_Expires; }
-};
-
-//
-// CDBGame
-//
-
-class CDBGame
-{
-private:
-	uint32_t m_ID;
-	string m_Server;
-	string m_Map;
-	string m_DateTime;
-	string m_GameName;
-	string m_OwnerName;
-	uint32_t m_Duration;
-
-public:
-	CDBGame( uint32_t nID, string nServer, string nMap, string nDateTime, string nGameName, string nOwnerName, uint32_t nDuration );
-	~CDBGame( );
-
-	uint32_t GetID( )		{ return m_ID; }
-	string GetServer( )		{ return m_Server; }
-	string GetMap( )		{ return m_Map; }
-	string GetDateTime( )	{ return m_DateTime; }
-	string GetGameName( )	{ return m_GameName; }
-	string GetOwnerName( )	{ return m_OwnerName; }
-	uint32_t GetDuration( )	{ return m_Duration; }
-
-	void SetDuration( uint32_t nDuration )	{ m_Duration = nDuration; }
-};
-
-//
-// CDBGamePlayer
-//
-
-class CDBGamePlayer
-{
-private:
-	uint32_t m_ID;
-	uint32_t m_GameID;
-	string m_Name;
-	string m_IP;
-	uint32_t m_Spoofed;
-	string m_SpoofedRealm;
-	uint32_t m_Reserved;
-	uint32_t m_LoadingTime;
-	uint32_t m_Left;
-	string m_LeftReason;
-	uint32_t m_Team;
-	uint32_t m_Colour;
-
-public:
-	CDBGamePlayer( uint32_t nID, uint32_t nGameID, string nName, string nIP, uint32_t nSpoofed, string nSpoofedRealm, uint32_t nReserved, uint32_t nLoadingTime, uint32_t nLeft, string nLeftReason, uint32_t nTeam, uint32_t nColour );
-	~CDBGamePlayer( );
-
-	uint32_t GetID( )			{ return m_ID; }
-	uint32_t GetGameID( )		{ return m_GameID; }
-	string GetName( )			{ return m_Name; }
-	string GetIP( )				{ return m_IP; }
-	uint32_t GetSpoofed( )		{ return m_Spoofed; }
-	string GetSpoofedRealm( )	{ return m_SpoofedRealm; }
-	uint32_t GetReserved( )		{ return m_Reserved; }
-	uint32_t GetLoadingTime( )	{ return m_LoadingTime; }
-	uint32_t GetLeft( )			{ return m_Left; }
-	string GetLeftReason( )		{ return m_LeftReason; }
-	uint32_t GetTeam( )			{ return m_Team; }
-	uint32_t GetColour( )		{ return m_Colour; }
-
-	void SetLoadingTime( uint32_t nLoadingTime )	{ m_LoadingTime = nLoadingTime; }
-	void SetLeft( uint32_t nLeft )					{ m_Left = nLeft; }
-	void SetLeftReason( string nLeftReason )		{ m_LeftReason = nLeftReason; }
-};
-
-//
-// CDBGamePlayerSummary
-//
-
-class CDBGamePlayerSummary
-{
-private:
-	string m_Server;
-	string m_Name;
-	string m_FirstGameDateTime;		// datetime of first game played
-	string m_LastGameDateTime;		// datetime of last game played
-	uint32_t m_TotalGames;			// total number of games played
-	uint32_t m_MinLoadingTime;		// minimum loading time in milliseconds (this could be skewed because different maps have different load times)
-	uint32_t m_AvgLoadingTime;		// average loading time in milliseconds (this could be skewed because different maps have different load times)
-	uint32_t m_MaxLoadingTime;		// maximum loading time in milliseconds (this could be skewed because different maps have different load times)
-	uint32_t m_MinLeftPercent;		// minimum time at which the player left the game expressed as a percentage of the game duration (0-100)
-	uint32_t m_AvgLeftPercent;		// average time at which the player left the game expressed as a percentage of the game duration (0-100)
-	uint32_t m_MaxLeftPercent;		// maximum time at which the player left the game expressed as a percentage of the game duration (0-100)
-	uint32_t m_MinDuration;			// minimum game duration in seconds
-	uint32_t m_AvgDuration;			// average game duration in seconds
-	uint32_t m_MaxDuration;			// maximum game duration in seconds
-	bool	 m_Vouched;
-	string	 m_VouchedBy;
-	string	m_AliasName;
-	bool	m_HasAlias;
-	uint32_t m_Season;
-	uint32_t m_AllTotalGames;			// total number of games played all season
-
-public:
-	CDBGamePlayerSummary( string nServer, string nName, string nFirstGameDateTime, string nLastGameDateTime, uint32_t nTotalGames, uint32_t nMinLoadingTime, uint32_t nAvgLoadingTime, uint32_t nMaxLoadingTime, uint32_t nMinLeftPercent, uint32_t nAvgLeftPercent, uint32_t nMaxLeftPercent, uint32_t nMinDuration, uint32_t nAvgDuration, uint32_t nMaxDuration );
-	CDBGamePlayerSummary( string nServer, string nName, string nFirstGameDateTime, string nLastGameDateTime, uint32_t nTotalGames, uint32_t nMinLoadingTime, uint32_t nAvgLoadingTime, uint32_t nMaxLoadingTime, uint32_t nMinLeftPercent, uint32_t nAvgLeftPercent, uint32_t nMaxLeftPercent, uint32_t nMinDuration, uint32_t nAvgDuration, uint32_t nMaxDuration, bool nVouched, string nVouchedBy );
-	~CDBGamePlayerSummary( );
-
-	string GetServer( )			{ return m_Server; }
-	string GetName( )			{ return m_Name; }
-	string GetAlias( )			{ return m_AliasName; }
-	string GetFirstGameDateTime( )		{ return m_FirstGameDateTime; }
-	string GetLastGameDateTime( )		{ return m_LastGameDateTime; }
-	uint32_t GetTotalGames( )		{ return m_TotalGames; }
-	uint32_t GetMinLoadingTime( )		{ return m_MinLoadingTime; }
-	uint32_t GetAvgLoadingTime( )		{ return m_AvgLoadingTime; }
-	uint32_t GetMaxLoadingTime( )		{ return m_MaxLoadingTime; }
-	uint32_t GetMinLeftPercent( )		{ return m_MinLeftPercent; }
-	uint32_t GetAvgLeftPercent( )		{ return m_AvgLeftPercent; }
-	uint32_t GetMaxLeftPercent( )		{ return m_MaxLeftPercent; }
-	uint32_t GetMinDuration( )		{ return m_MinDuration; }
-	uint32_t GetAvgDuration( )		{ return m_AvgDuration; }
-	uint32_t GetMaxDuration( )		{ return m_MaxDuration; }
-	bool	 IsVouched( )			{ return m_Vouched; }
-	string	 GetVouchedBy( )		{ return m_VouchedBy; }
-	void	SetVouched(bool nVouched) 	{ m_Vouched = nVouched; }
-	void	SetVouchedBy(string nName) 	{ m_VouchedBy = nName; }
-	void SetAlias( string nName )		{ m_AliasName = nName; }
-	bool HasAlias( )			{ return m_HasAlias; }
-	bool HasAlias( bool nHasAlias )			{ m_HasAlias = nHasAlias; }
-	
-	uint32_t GetAllTotalGames( )		{ return m_AllTotalGames; }
-	void SetAllTotalGames( uint32_t nGames )		{ m_AllTotalGames = nGames; }
-};
-
-//
-// CDBDotAGame
-//
-
-class CDBDotAGame
-{
-private:
-	uint32_t m_ID;
-	uint32_t m_GameID;
-	uint32_t m_Winner;
-	uint32_t m_Min;
-	uint32_t m_Sec;
-
-public:
-	CDBDotAGame( uint32_t nID, uint32_t nGameID, uint32_t nWinner, uint32_t nMin, uint32_t nSec );
-	~CDBDotAGame( );
-
-	uint32_t GetID( )		{ return m_ID; }
-	uint32_t GetGameID( )	{ return m_GameID; }
-	uint32_t GetWinner( )	{ return m_Winner; }
-	uint32_t GetMin( )		{ return m_Min; }
-	uint32_t GetSec( )		{ return m_Sec; }
-};
-
-//
-// CDBDotAPlayer
-//
-
-class CDBDotAPlayer
-{
-private:
-	uint32_t m_ID;
-	uint32_t m_GameID;
-	uint32_t m_Colour;
-	uint32_t m_Kills;
-	uint32_t m_Deaths;
-	uint32_t m_CreepKills;
-	uint32_t m_CreepDenies;
-	uint32_t m_Assists;
-	uint32_t m_Gold;
-	uint32_t m_NeutralKills;
-	string m_Items[6];
-	string m_Hero;
-	uint32_t m_NewColour;
-	uint32_t m_TowerKills;
-	uint32_t m_RaxKills;
-	uint32_t m_CourierKills;
-	
-	// nordicleague
-	string 	 m_Name;
-	uint32_t m_Rank;
-	uint32_t m_Score;
-	uint32_t m_Outcome;
-	uint32_t m_Level;
-	uint32_t m_Apm;
-
-public:
-	CDBDotAPlayer( );
-	CDBDotAPlayer( uint32_t nID, string nName, uint32_t nGameID, uint32_t nColour, uint32_t nKills, uint32_t nDeaths, uint32_t nCreepKills, uint32_t nCreepDenies, uint32_t nAssists, uint32_t nGold, uint32_t nNeutralKills, string nItem1, string nItem2, string nItem3, string nItem4, string nItem5, string nItem6, string nHero, uint32_t nNewColour, uint32_t nTowerKills, uint32_t nRaxKills, uint32_t nCourierKills, uint32_t nOutcome, uint32_t nLevel, uint32_t nApm );
-	CDBDotAPlayer( uint32_t nID, string nName, uint32_t nGameID, uint32_t nColour, uint32_t nKills, uint32_t nDeaths, uint32_t nCreepKills, uint32_t nCreepDenies, uint32_t nAssists, uint32_t nGold, uint32_t nNeutralKills, string nItem1, string nItem2, string nItem3, string nItem4, string nItem5, string nItem6, string nHero, uint32_t nNewColour, uint32_t nTowerKills, uint32_t nRaxKills, uint32_t nCourierKills, uint32_t nRank, uint32_t nScore, uint32_t nOutcome, uint32_t nLevel, uint32_t nApm );
-	~CDBDotAPlayer( );
-
-	uint32_t GetID( )			{ return m_ID; }
-	uint32_t GetGameID( )		{ return m_GameID; }
-	uint32_t GetColour( )		{ return m_Colour; }
-	uint32_t GetKills( )		{ return m_Kills; }
-	uint32_t GetDeaths( )		{ return m_Deaths; }
-	uint32_t GetCreepKills( )	{ return m_CreepKills; }
-	uint32_t GetCreepDenies( )	{ return m_CreepDenies; }
-	uint32_t GetAssists( )		{ return m_Assists; }
-	uint32_t GetGold( )			{ return m_Gold; }
-	uint32_t GetNeutralKills( )	{ return m_NeutralKills; }
-	string GetItem( unsigned int i );
-	string GetHero( )			{ return m_Hero; }
-	uint32_t GetNewColour( )	{ return m_NewColour; }
-	uint32_t GetTowerKills( )	{ return m_TowerKills; }
-	uint32_t GetRaxKills( )		{ return m_RaxKills; }
-	uint32_t GetCourierKills( )	{ return m_CourierKills; }
-	
-	// nordicleague
-	
-	uint32_t GetRank( )			{ return m_Rank; }
-	uint32_t GetScore( )		{ return m_Score; }
-	uint32_t GetOutcome()		{ return m_Outcome; }
-	string 	 GetName()			{ return m_Name; }
-	uint32_t GetLevel()			{ return m_Level; }
-	uint32_t GetApm() 			{ return m_Apm; }
-	
-	
-
-	void SetColour( uint32_t nColour )				{ m_Colour = nColour; }
-	void SetKills( uint32_t nKills )				{ m_Kills = nKills; }
-	void SetDeaths( uint32_t nDeaths )				{ m_Deaths = nDeaths; }
-	void SetCreepKills( uint32_t nCreepKills )		{ m_CreepKills = nCreepKills; }
-	void SetCreepDenies( uint32_t nCreepDenies )	{ m_CreepDenies = nCreepDenies; }
-	void SetAssists( uint32_t nAssists )			{ m_Assists = nAssists; }
-	void SetGold( uint32_t nGold )					{ m_Gold = nGold; }
-	void SetNeutralKills( uint32_t nNeutralKills )	{ m_NeutralKills = nNeutralKills; }
-	void SetItem( unsigned int i, string item );
-	void SetHero( string nHero )					{ m_Hero = nHero; }
-	void SetNewColour( uint32_t nNewColour )		{ m_NewColour = nNewColour; }
-	void SetTowerKills( uint32_t nTowerKills )		{ m_TowerKills = nTowerKills; }
-	void SetRaxKills( uint32_t nRaxKills )			{ m_RaxKills = nRaxKills; }
-	void SetCourierKills( uint32_t nCourierKills )	{ m_CourierKills = nCourierKills; }
-	
-	// nordicleague
-	
-	void SetRank( uint32_t nRank )					{ m_Rank = nRank; }
-	void SetScore( uint32_t nScore )				{ m_Score = nScore; }
-	void SetOutcome( uint32_t nOutcome )			{ m_Outcome = nOutcome; }
-	void SetName( string nName )					{ m_Name = nName; }
-	void SetLevel( uint32_t nLevel )				{ m_Level = nLevel; } 
-	void SetApm( uint32_t nApm )					{ m_Apm = nApm; }
-};
-
-//
-// CDBDotAPlayerSummary
-//
-
-class CDBDotAPlayerSummary
-{
-private:
-	string m_Server;
-	string m_Name;
-	uint32_t m_TotalGames;			// total number of dota games played
-	uint32_t m_TotalWins;			// total number of dota games won
-	uint32_t m_TotalLosses;			// total number of dota games lost
-	uint32_t m_TotalKills;			// total number of hero kills
-	uint32_t m_TotalDeaths;			// total number of deaths
-	uint32_t m_TotalCreepKills;		// total number of creep kills
-	uint32_t m_TotalCreepDenies;	// total number of creep denies
-	uint32_t m_TotalAssists;		// total number of assists
-	uint32_t m_TotalNeutralKills;	// total number of neutral kills
-	uint32_t m_TotalTowerKills;		// total number of tower kills
-	uint32_t m_TotalRaxKills;		// total number of rax kills
-	uint32_t m_TotalCourierKills;	// total number of courier kills
-	
-	// nordicleague
-	
-	uint32_t m_Rank;
-	double 	 m_Score;
-	uint32_t m_Streak;
-
-public:
-	CDBDotAPlayerSummary( string nServer, string nName, uint32_t nTotalGames, uint32_t nTotalWins, uint32_t nTotalLosses, uint32_t nTotalKills, uint32_t nTotalDeaths, uint32_t nTotalCreepKills, uint32_t nTotalCreepDenies, uint32_t nTotalAssists, uint32_t nTotalNeutralKills, uint32_t nTotalTowerKills, uint32_t nTotalRaxKills, uint32_t nTotalCourierKills );
-	CDBDotAPlayerSummary( string nServer, string nName, uint32_t nTotalGames, uint32_t nTotalWins, uint32_t nTotalLosses, uint32_t nTotalKills, uint32_t nTotalDeaths, uint32_t nTotalCreepKills, uint32_t nTotalCreepDenies, uint32_t nTotalAssists, uint32_t nTotalNeutralKills, uint32_t nTotalTowerKills, uint32_t nTotalRaxKills, uint32_t nTotalCourierKills, uint32_t nRank, double nScore );
-	CDBDotAPlayerSummary( string nServer, string nName, uint32_t nTotalGames, uint32_t nTotalWins, uint32_t nTotalLosses, uint32_t nTotalKills, uint32_t nTotalDeaths, uint32_t nTotalCreepKills, uint32_t nTotalCreepDenies, uint32_t nTotalAssists, uint32_t nTotalNeutralKills, uint32_t nTotalTowerKills, uint32_t nTotalRaxKills, uint32_t nTotalCourierKills, uint32_t nRank, double nScore, uint32_t nStreak );
-	~CDBDotAPlayerSummary( );
-
-	string GetServer( )					{ return m_Server; }
-	string GetName( )					{ return m_Name; }
-	uint32_t GetTotalGames( )			{ return m_TotalGames; }
-	uint32_t GetTotalWins( )			{ return m_TotalWins; }
-	uint32_t GetTotalLosses( )			{ return m_TotalLosses; }
-	uint32_t GetTotalKills( )			{ return m_TotalKills; }
-	uint32_t GetTotalDeaths( )			{ return m_TotalDeaths; }
-	uint32_t GetTotalCreepKills( )		{ return m_TotalCreepKills; }
-	uint32_t GetTotalCreepDenies( )		{ return m_TotalCreepDenies; }
-	uint32_t GetTotalAssists( )			{ return m_TotalAssists; }
-	uint32_t GetTotalNeutralKills( )	{ return m_TotalNeutralKills; }
-	uint32_t GetTotalTowerKills( )		{ return m_TotalTowerKills; }
-	uint32_t GetTotalRaxKills( )		{ return m_TotalRaxKills; }
-	uint32_t GetTotalCourierKills( )	{ return m_TotalCourierKills; }
-	
-	// nordicleague
-	
-	uint32_t GetRank( )					{ return m_Rank; }
-	double 	 GetScore( )				{ return m_Score; }
-	uint32_t GetStreak( )				{ return m_Streak; }
-
-	float GetAvgKills( )				{ return m_TotalGames > 0 ? (float)m_TotalKills / m_TotalGames : 0; }
-	float GetAvgDeaths( )				{ return m_TotalGames > 0 ? (float)m_TotalDeaths / m_TotalGames : 0; }
-	float GetAvgCreepKills( )			{ return m_TotalGames > 0 ? (float)m_TotalCreepKills / m_TotalGames : 0; }
-	float GetAvgCreepDenies( )			{ return m_TotalGames > 0 ? (float)m_TotalCreepDenies / m_TotalGames : 0; }
-	float GetAvgAssists( )				{ return m_TotalGames > 0 ? (float)m_TotalAssists / m_TotalGames : 0; }
-	float GetAvgNeutralKills( )			{ return m_TotalGames > 0 ? (float)m_TotalNeutralKills / m_TotalGames : 0; }
-	float GetAvgTowerKills( )			{ return m_TotalGames > 0 ? (float)m_TotalTowerKills / m_TotalGames : 0; }
-	float GetAvgRaxKills( )				{ return m_TotalGames > 0 ? (float)m_TotalRaxKills / m_TotalGames : 0; }
-	float GetAvgCourierKills( )			{ return m_TotalGames > 0 ? (float)m_TotalCourierKills / m_TotalGames : 0; }
-};
-
-
-// nordicleague
-
-
-class CCallableRegisterPlayerAdd : virtual public CBaseCallable
-{
-protected:
-	string m_Name, m_Email, m_IP;
-	uint32_t m_Result;
-
-public:
-	CCallableRegisterPlayerAdd( string nName, string nEmail, string nIP) : CBaseCallable( ), m_Name( nName ), m_IP( nIP ),m_Email( nEmail ), m_Result( 0 ) { }
-	virtual ~CCallableRegisterPlayerAdd( );
-
-	virtual string GetUser() { return m_Name; }
-	virtual string GetMail() { return m_Email; }
-
-	virtual uint32_t GetResult( )				{ return m_Result; }
-	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
-};
-
-//
-// CDBLastSeenPlayer
-//
-
-class CDBLastSeenPlayer
-{
-private:
-	bool 		m_Seen;
-	string 		m_Name;
-	string 		m_Date;
-	string 		m_LastGame;
-	string 		m_LastHero;
-	uint32_t 	m_LastTeam;
-	uint32_t 	m_LastOutcome;
-	double 		m_LastGain;
-	uint32_t 	m_Kills;
-	uint32_t 	m_Deaths;
-	uint32_t 	m_Assists;
-
-public:
-	CDBLastSeenPlayer( string nName );
-	CDBLastSeenPlayer( bool nSeen, string nName );
-	CDBLastSeenPlayer( bool nSeen, string nName, string nDate, string nLastGame, string nLastHero, uint32_t nLastTeam, uint32_t nLastOutcome, double nLastGain, uint32_t nKills, uint32_t nDeaths, uint32_t nAssists );
-	~CDBLastSeenPlayer( );
-
-	bool 		Seen( )				{ return m_Seen; }
-	string 		GetName( )			{ return m_Name; }
-	string 		GetDate( )			{ return m_Date; }
-	string 		GetLastGame( )		{ return m_LastGame; }
-	string 		GetLastHero( )		{ return m_LastHero; }
-	uint32_t 	GetLastTeam( )		{ return m_LastTeam; }
-	uint32_t 	GetLastOutcome( )	{ return m_LastOutcome; }
-	double 		GetLastGain( )		{ return m_LastGain; }
-	uint32_t 	GetKills( )			{ return m_Kills; }
-	uint32_t 	GetDeaths( )		{ return m_Deaths; }
-	uint32_t 	GetAssists( )		{ return m_Assists; }
-	string		GetKDA()			{ return UTIL_ToString(m_Kills) + "/" + UTIL_ToString(m_Deaths) + "/" + UTIL_ToString(m_Assists); }
-
-};
-
-class CCallableLastSeenPlayer : virtual public CBaseCallable
-{
-protected:
-	string 				m_Name;
-	CDBLastSeenPlayer 	*m_Result;
-
-public:
-	CCallableLastSeenPlayer( string nName ) : CBaseCallable( ), m_Name( nName ), m_Result( 0 ) { }
-	virtual ~CCallableLastSeenPlayer( );
-
-	virtual string 				GetName() 								{ return m_Name; }
-
-	virtual CDBLastSeenPlayer 	*GetResult( )							{ return m_Result; }
-	virtual void 				SetResult( CDBLastSeenPlayer *nResult )	{ m_Result = nResult; }
-};
-
-class CCallableSaveReplay : virtual public CBaseCallable
-{
-protected:
-	CReplay *m_Replay;
-	bool m_Result;
-
-public:
-	CCallableSaveReplay( CReplay *replay ) : CBaseCallable( ), m_Replay( replay ), m_Result( false ) { }
-	virtual ~CCallableSaveReplay( );
-
-	virtual bool GetResult( )					{ return m_Result; }
-	virtual void SetResult( bool nResult )		{ m_Result = nResult; }
-};
-
-#endif
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#ifndef GHOSTDB_H
+#define GHOSTDB_H
+
+#define GI_NEW_GAME 0
+#define GI_STARTUP 200
+#define GI_CLEANUP 210
+#define GI_ACTIVATE_GAME 220
+#define GI_DELETE_GAME 255
+
+namespace boost { class thread; class mutex; class condition_variable; }
+
+
+//
+// CGHostDB
+//
+
+class CBaseCallable;
+class CCallableAdminCount;
+class CCallableAdminCheck;
+class CCallableAdminAdd;
+class CCallableAdminRemove;
+class CCallableAdminList;
+class CCallableBanCount;
+class CCallableBanCheck;
+class CCallableBanAdd;
+class CCallableBanRemove;
+class CCallableBanList;
+class CCallableGameAdd;
+class CCallableGamePlayerAdd;
+class CCallableGamePlayerSummaryCheck;
+class CCallableDotAGameAdd;
+class CCallableDotAPlayerAdd;
+class CCallableDotAPlayerSummaryCheck;
+class CCallableDownloadAdd;
+class CCallableScoreCheck;
+class CCallableW3MMDPlayerAdd;
+class CCallableW3MMDVarAdd;
+class CDBBan;
+class CBanList;
+class CDBGame;
+class CDBGamePlayer;
+class CDBGamePlayerSummary;
+class CDBDotAPlayerSummary;
+
+
+// nordicleague 
+class CDBLastSeenPlayer;
+class CCallableLastSeenPlayer;
+class CCallableRegisterPlayerAdd;
+class CCallableDotAEventAdd;
+class CCallableUpdateGameInfo;
+class CCallableSeenPlayer;
+class CCallableSaveReplay;
+class CCallableCountrySkipList;
+class CCallableVouchList;
+
+class CPacked;
+class CReplay;
+
+typedef pair<uint32_t,string> VarP;
+
+class CGHostDB
+{
+protected:
+	bool m_HasError;
+	string m_Error;
+
+public:
+	CGHostDB( CConfig *CFG );
+	virtual ~CGHostDB( );
+
+	bool HasError( )			{ return m_HasError; }
+	string GetError( )			{ return m_Error; }
+	virtual string GetStatus( )	{ return "DB STATUS --- OK"; }
+
+	virtual void RecoverCallable( CBaseCallable *callable );
+	virtual vector<CBaseCallable *> DrainCallables( )	{ return vector<CBaseCallable *>( ); }
+
+	// standard (non-threaded) database functions
+
+	virtual bool Begin( );
+	virtual bool Commit( );
+	virtual uint32_t AdminCount( string server );
+	virtual bool AdminCheck( string server, string user );
+	virtual bool AdminAdd( string server, string user );
+	virtual bool AdminRemove( string server, string user );
+	virtual vector<string> AdminList( string server );
+	virtual uint32_t BanCount( string server );
+	virtual CDBBan *BanCheck( string server, string user, string ip );
+	virtual bool BanAdd( string server, string user, string ip, string gamename, string admin, string reason, uint32_t bantime = 0, uint32_t ipban = 0 );
+	virtual bool BanRemove( string server, string user, string admin, string reason = "" );
+	virtual bool BanRemove( string user, string admin, string reason = "" );
+	virtual CBanList *BanList( string server, uint32_t sinceid );
+	virtual uint32_t GameAdd( string server, string map, string gamename, string ownername, uint32_t duration, uint32_t gamestate, string creatorname, string creatorserver );
+	virtual uint32_t GamePlayerAdd( uint32_t gameid, string name, string ip, uint32_t spoofed, string spoofedrealm, uint32_t reserved, uint32_t loadingtime, uint32_t left, string leftreason, uint32_t team, uint32_t colour );
+	virtual uint32_t GamePlayerCount( string name );
+	virtual CDBGamePlayerSummary *GamePlayerSummaryCheck( string name );
+	virtual uint32_t DotAGameAdd( uint32_t gameid, uint32_t winner, uint32_t min, uint32_t sec );
+	virtual uint32_t DotAPlayerAdd( uint32_t gameid, string name, uint32_t colour, uint32_t kills, uint32_t deaths, uint32_t creepkills, uint32_t creepdenies, uint32_t assists, uint32_t gold, uint32_t neutralkills, string item1, string item2, string item3, string item4, string item5, string item6, string hero, uint32_t newcolour, uint32_t towerkills, uint32_t raxkills, uint32_t courierkills, uint32_t outcome, uint32_t level, uint32_t apm );
+	virtual uint32_t DotAPlayerCount( string name );
+	virtual CDBDotAPlayerSummary *DotAPlayerSummaryCheck( string name );
+	virtual string FromCheck( uint32_t ip );
+	virtual bool FromAdd( uint32_t ip1, uint32_t ip2, string country );
+	virtual bool DownloadAdd( string map, uint32_t mapsize, string name, string ip, uint32_t spoofed, string spoofedrealm, uint32_t downloadtime );
+	virtual uint32_t W3MMDPlayerAdd( string category, uint32_t gameid, uint32_t pid, string name, string flag, uint32_t leaver, uint32_t practicing );
+	virtual bool W3MMDVarAdd( uint32_t gameid, map<VarP,int32_t> var_ints );
+	virtual bool W3MMDVarAdd( uint32_t gameid, map<VarP,double> var_reals );
+	virtual bool W3MMDVarAdd( uint32_t gameid, map<VarP,string> var_strings );
+	
+	
+	// nordicleague
+	
+	virtual uint32_t 					RegisterPlayerAdd( string name, string email, string ip );
+	virtual CCallableRegisterPlayerAdd 	*ThreadedRegisterPlayerAdd( string name, string email, string ip );
+	
+	virtual uint32_t 					DotAEventAdd( uint32_t gameid, string gamename, string killer, string victim, uint32_t kcolour, uint32_t vcolour );
+	virtual CCallableDotAEventAdd 		*ThreadedDotAEventAdd( uint32_t gameid, string gamename, string Killer, string Victim, uint32_t kcolour, uint32_t vcolour );
+	
+	// Keep track of current games in database for channel/website info
+	
+	virtual bool 						UpdateGameInfo( string name, uint32_t players, bool ispublic, vector<string> m_Slots);
+	virtual CCallableUpdateGameInfo 	*ThreadedUpdateGameInfo( string name, uint32_t players, bool ispublic, vector<string> m_Slots );
+	
+	virtual CDBLastSeenPlayer			*LastSeenPlayer( string name );
+	virtual CCallableLastSeenPlayer 	*ThreadedLastSeenPlayer( string name );
+	
+	virtual bool 						SaveReplay( CReplay *replay );
+	virtual CCallableSaveReplay 		*ThreadedSaveReplay( CReplay *replay );
+	
+	virtual set<string> 				CountrySkipList( );
+	virtual CCallableCountrySkipList 	*ThreadedCountrySkipList( );
+
+	virtual set<VouchPair> 				VouchList( );
+	virtual CCallableVouchList			*ThreadedVouchList( );
+
+	// threaded database functions
+
+	virtual void CreateThread( CBaseCallable *callable );
+	virtual CCallableAdminCount *ThreadedAdminCount( string server );
+	virtual CCallableAdminCheck *ThreadedAdminCheck( string server, string user );
+	virtual CCallableAdminAdd *ThreadedAdminAdd( string server, string user );
+	virtual CCallableAdminRemove *ThreadedAdminRemove( string server, string user );
+	virtual CCallableAdminList *ThreadedAdminList( string server );
+	virtual CCallableBanCount *ThreadedBanCount( string server );
+	virtual CCallableBanCheck *ThreadedBanCheck( string server, string user, string ip );
+	virtual CCallableBanAdd *ThreadedBanAdd( string server, string user, string ip, string gamename, string admin, string reason, uint32_t bantime = 0, uint32_t ipban = 0 );
+	virtual CCallableBanRemove *ThreadedBanRemove( string server, string user, string admin, string reason );
+	virtual CCallableBanRemove *ThreadedBanRemove( string user, string admin, string reason = "" );
+	virtual CCallableBanList *ThreadedBanList( string server, uint32_t sinceid = 0 );
+	virtual CCallableGameAdd *ThreadedGameAdd( string server, string map, string gamename, string ownername, uint32_t duration, uint32_t gamestate, string creatorname, string creatorserver, vector<string> chatlog );
+	virtual CCallableGamePlayerAdd *ThreadedGamePlayerAdd( uint32_t gameid, string name, string ip, uint32_t spoofed, string spoofedrealm, uint32_t reserved, uint32_t loadingtime, uint32_t left, string leftreason, uint32_t team, uint32_t colour );
+	virtual CCallableGamePlayerSummaryCheck *ThreadedGamePlayerSummaryCheck( string name, uint32_t season = 2 );
+	virtual CCallableDotAGameAdd *ThreadedDotAGameAdd( uint32_t gameid, uint32_t winner, uint32_t min, uint32_t sec );
+	virtual CCallableDotAPlayerAdd *ThreadedDotAPlayerAdd( uint32_t gameid, string name, uint32_t colour, uint32_t kills, uint32_t deaths, uint32_t creepkills, uint32_t creepdenies, uint32_t assists, uint32_t gold, uint32_t neutralkills, string item1, string item2, string item3, string item4, string item5, string item6, string hero, uint32_t newcolour, uint32_t towerkills, uint32_t raxkills, uint32_t courierkills, uint32_t outcome, uint32_t level, uint32_t apm );
+	virtual CCallableDotAPlayerSummaryCheck *ThreadedDotAPlayerSummaryCheck( string name, uint32_t season = 2);
+	virtual CCallableDownloadAdd *ThreadedDownloadAdd( string map, uint32_t mapsize, string name, string ip, uint32_t spoofed, string spoofedrealm, uint32_t downloadtime );
+	virtual CCallableScoreCheck *ThreadedScoreCheck( string category, string name, string server, uint32_t season = 2 );
+	virtual CCallableW3MMDPlayerAdd *ThreadedW3MMDPlayerAdd( string category, uint32_t gameid, uint32_t pid, string name, string flag, uint32_t leaver, uint32_t practicing );
+	virtual CCallableW3MMDVarAdd *ThreadedW3MMDVarAdd( uint32_t gameid, map<VarP,int32_t> var_ints );
+	virtual CCallableW3MMDVarAdd *ThreadedW3MMDVarAdd( uint32_t gameid, map<VarP,double> var_reals );
+	virtual CCallableW3MMDVarAdd *ThreadedW3MMDVarAdd( uint32_t gameid, map<VarP,string> var_strings );
+};
+
+//
+// Callables
+//
+
+// life cycle of a callable:
+//  - the callable is created in one of the database's ThreadedXXX functions
+//  - initially the callable is NOT ready (i.e. m_Ready = false)
+//  - the ThreadedXXX function normally queues the callable on a CCallablePool where a worker thread performs some query and (potentially) stores some result in the callable
+//  - when the worker completes the callable it pushes it onto the pool's completed list, it does NOT set m_Ready = true itself
+//  - CGHost :: Update calls the database's DrainCallables function once per loop which sets m_Ready = true on every completed callable from the main thread
+//  - DO NOT DO *ANYTHING* TO THE CALLABLE UNTIL IT'S READY OR YOU WILL CREATE A CONCURRENCY MESS
+//  - THE ONLY SAFE FUNCTION IN THE CALLABLE IS GetReady
+//  - when the callable is ready you may access the callable's result which will have been set within the (now terminated) thread
+
+// example usage:
+//  - normally you will call a ThreadedXXX function, store the callable in a vector, and periodically check if the callable is ready
+//  - when the callable is ready you will consume the result then you will pass the callable back to the database via the RecoverCallable function
+//  - the RecoverCallable function allows the database to recover some of the callable's resources to be reused later (e.g. MySQL connections)
+//  - note that this will NOT free the callable's memory, you must do that yourself after calling the RecoverCallable function
+//  - be careful not to leak any callables, it's NOT safe to delete a callable even if you decide that you don't want the result anymore
+//  - you should deliver any to-be-orphaned callables to the main vector in CGHost so they can be properly deleted when ready even if you don't care about the result anymore
+//  - e.g. if a player does a stats check immediately before a game is deleted you can't just delete the callable on game deletion unless it's ready
+
+class CBaseCallable
+{
+protected:
+	string m_Error;
+	volatile bool m_Ready;
+	uint32_t m_QueuedTicks;
+	uint32_t m_StartTicks;
+	uint32_t m_EndTicks;
+	CBaseCallable *m_NextCompleted;		// the next callable in the CCallablePool's completed list
+
+public:
+	CBaseCallable( ) : m_Error( ), m_Ready( false ), m_QueuedTicks( GetTicks( ) ), m_StartTicks( 0 ), m_EndTicks( 0 ), m_NextCompleted( NULL ) { }
+	virtual ~CBaseCallable( ) { }
+
+	virtual void operator( )( ) { }
+
+	virtual void Init( );
+	virtual void Close( );
+
+	virtual string GetError( )				{ return m_Error; }
+	virtual bool GetReady( )				{ return m_Ready; }
+	virtual void SetReady( bool nReady )	{ m_Ready = nReady; }
+	virtual uint32_t GetElapsed( )			{ return m_Ready ? m_EndTicks - m_StartTicks : 0; }
+	virtual uint32_t GetQueuedTicks( )		{ return m_QueuedTicks; }
+	CBaseCallable *GetNextCompleted( )		{ return m_NextCompleted; }
+	void SetNextCompleted( CBaseCallable *nNextCompleted )	{ m_NextCompleted = nNextCompleted; }
+};
+
+//
+// CCallablePool
+//
+
+// a fixed number of worker threads which run callables from a bounded queue
+//  - Push blocks the calling thread while the queue is full
+//  - completed callables are pushed onto a lock free list (linked through CBaseCallable :: m_NextCompleted) so the workers never wait on the main thread
+//  - Drain takes the whole completed list at once, marks every callable ready, and returns them in the order they completed
+
+class CCallablePool
+{
+private:
+	vector<boost::thread *> m_Workers;
+	boost::mutex *m_Mutex;
+	boost::condition_variable *m_NotEmpty;
+	boost::condition_variable *m_NotFull;
+	queue<CBaseCallable *> m_Queue;
+	uint32_t m_MaxQueued;
+	bool m_Exiting;
+	CBaseCallable * volatile m_Completed;
+
+public:
+	CCallablePool( uint32_t numWorkers, uint32_t maxQueued );
+	~CCallablePool( );
+
+	uint32_t GetNumWorkers( )	{ return m_Workers.size( ); }
+	uint32_t GetNumQueued( );
+
+	void Push( CBaseCallable *callable );
+	vector<CBaseCallable *> Drain( );
+
+private:
+	void WorkerThread( );
+	void PushCompleted( CBaseCallable *callable );
+};
+
+class CCallableAdminCount : virtual public CBaseCallable
+{
+protected:
+	string m_Server;
+	uint32_t m_Result;
+
+public:
+	CCallableAdminCount( string nServer ) : CBaseCallable( ), m_Server( nServer ), m_Result( 0 ) { }
+	virtual ~CCallableAdminCount( );
+
+	virtual string GetServer( )					{ return m_Server; }
+	virtual uint32_t GetResult( )				{ return m_Result; }
+	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
+};
+
+class CCallableAdminCheck : virtual public CBaseCallable
+{
+protected:
+	string m_Server;
+	string m_User;
+	bool m_Result;
+
+public:
+	CCallableAdminCheck( string nServer, string nUser ) : CBaseCallable( ), m_Server( nServer ), m_User( nUser ), m_Result( false ) { }
+	virtual ~CCallableAdminCheck( );
+
+	virtual string GetServer( )				{ return m_Server; }
+	virtual string GetUser( )				{ return m_User; }
+	virtual bool GetResult( )				{ return m_Result; }
+	virtual void SetResult( bool nResult )	{ m_Result = nResult; }
+};
+
+class CCallableAdminAdd : virtual public CBaseCallable
+{
+protected:
+	string m_Server;
+	string m_User;
+	bool m_Result;
+
+public:
+	CCallableAdminAdd( string nServer, string nUser ) : CBaseCallable( ), m_Server( nServer ), m_User( nUser ), m_Result( false ) { }
+	virtual ~CCallableAdminAdd( );
+
+	virtual string GetServer( )				{ return m_Server; }
+	virtual string GetUser( )				{ return m_User; }
+	virtual bool GetResult( )				{ return m_Result; }
+	virtual void SetResult( bool nResult )	{ m_Result = nResult; }
+};
+
+class CCallableAdminRemove : virtual public CBaseCallable
+{
+protected:
+	string m_Server;
+	string m_User;
+	bool m_Result;
+
+public:
+	CCallableAdminRemove( string nServer, string nUser ) : CBaseCallable( ), m_Server( nServer ), m_User( nUser ), m_Result( false ) { }
+	virtual ~CCallableAdminRemove( );
+
+	virtual string GetServer( )				{ return m_Server; }
+	virtual string GetUser( )				{ return m_User; }
+	virtual bool GetResult( )				{ return m_Result; }
+	virtual void SetResult( bool nResult )	{ m_Result = nResult; }
+};
+
+class CCallableAdminList : virtual public CBaseCallable
+{
+protected:
+	string m_Server;
+	vector<string> m_Result;
+
+public:
+	CCallableAdminList( string nServer ) : CBaseCallable( ), m_Server( nServer ) { }
+	virtual ~CCallableAdminList( );
+
+	virtual vector<string> GetResult( )					{ return m_Result; }
+	virtual void SetResult( vector<string> nResult )	{ m_Result = nResult; }
+};
+
+class CCallableBanCount : virtual public CBaseCallable
+{
+protected:
+	string m_Server;
+	uint32_t m_Result;
+
+public:
+	CCallableBanCount( string nServer ) : CBaseCallable( ), m_Server( nServer ), m_Result( 0 ) { }
+	virtual ~CCallableBanCount( );
+
+	virtual string GetServer( )					{ return m_Server; }
+	virtual uint32_t GetResult( )				{ return m_Result; }
+	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
+};
+
+class CCallableBanCheck : virtual public CBaseCallable
+{
+protected:
+	string m_Server;
+	string m_User;
+	string m_IP;
+	CDBBan *m_Result;
+
+public:
+	CCallableBanCheck( string nServer, string nUser, string nIP ) : CBaseCallable( ), m_Server( nServer ), m_User( nUser ), m_IP( nIP ), m_Result( NULL ) { }
+	virtual ~CCallableBanCheck( );
+
+	virtual string GetServer( )					{ return m_Server; }
+	virtual string GetUser( )					{ return m_User; }
+	virtual string GetIP( )						{ return m_IP; }
+	virtual CDBBan *GetResult( )				{ return m_Result; }
+	virtual void SetResult( CDBBan *nResult )	{ m_Result = nResult; }
+};
+
+class CCallableBanAdd : virtual public CBaseCallable
+{
+protected:
+	string m_Server;
+	string m_User;
+	string m_IP;
+	string m_GameName;
+	string m_Admin;
+	string m_Reason;
+	uint32_t m_BanTime;
+	uint32_t m_IPBan;
+	bool m_Result;
+
+public:
+	CCallableBanAdd( string nServer, string nUser, string nIP, string nGameName, string nAdmin, string nReason, uint32_t nBanTime, uint32_t nIPBan ) : CBaseCallable( ), m_Server( nServer ), m_User( nUser ), m_IP( nIP ), m_GameName( nGameName ), m_Admin( nAdmin ), m_Reason( nReason ), m_BanTime( nBanTime), m_IPBan( nIPBan ), m_Result( false ) { }
+	virtual ~CCallableBanAdd( );
+
+	virtual string GetServer( )				{ return m_Server; }
+	virtual string GetUser( )				{ return m_User; }
+	virtual string GetIP( )					{ return m_IP; }
+	virtual string GetGameName( )			{ return m_GameName; }
+	virtual string GetAdmin( )				{ return m_Admin; }
+	virtual string GetReason( )				{ return m_Reason; }
+	virtual uint32_t GetBanTime( )			{ return m_BanTime; }
+	virtual uint32_t GetIPBan( )			{ return m_IPBan; }
+	virtual bool GetResult( )				{ return m_Result; }
+	virtual void SetResult( bool nResult )	{ m_Result = nResult; }
+};
+
+class CCallableBanRemove : virtual public CBaseCallable
+{
+protected:
+	string m_Server;
+	string m_User;
+	string m_Admin;
+	string m_Reason;
+	bool m_Result;
+
+public:
+	CCallableBanRemove( string nServer, string nUser, string nAdmin, string nReason ) : CBaseCallable( ), m_Server( nServer ), m_User( nUser ), m_Admin( nAdmin ), m_Reason( nReason ), m_Result( false ) { }
+	virtual ~CCallableBanRemove( );
+
+	virtual string GetServer( )				{ return m_Server; }
+	virtual string GetUser( )				{ return m_User; }
+	virtual string GetAdmin( )				{ return m_Admin; }
+	virtual string GetReason( )				{ return m_Reason; }
+	virtual bool GetResult( )				{ return m_Result; }
+	virtual void SetResult( bool nResult )	{ m_Result = nResult; }
+};
+
+// if sinceid is 0 this fetches every ban on the server
+// otherwise it only fetches the bans with a higher id and sets the result's total to the number of bans on the server so the caller can tell if any were removed
+
+class CCallableBanList : virtual public CBaseCallable
+{
+protected:
+	string m_Server;
+	uint32_t m_SinceID;
+	CBanList *m_Result;
+
+public:
+	CCallableBanList( string nServer, uint32_t nSinceID ) : CBaseCallable( ), m_Server( nServer ), m_SinceID( nSinceID ), m_Result( NULL ) { }
+	virtual ~CCallableBanList( );
+
+	virtual uint32_t GetSinceID( )					{ return m_SinceID; }
+	virtual CBanList *GetResult( )					{ return m_Result; }
+	virtual void SetResult( CBanList *nResult )		{ m_Result = nResult; }
+};
+
+class CCallableGameAdd : virtual public CBaseCallable
+{
+protected:
+	string m_Server;
+	string m_Map;
+	string m_GameName;
+	string m_OwnerName;
+	uint32_t m_Duration;
+	uint32_t m_GameState;
+	string m_CreatorName;
+	string m_CreatorServer;
+	vector<string> m_ChatLog;
+	uint32_t m_Result;
+
+public:
+	CCallableGameAdd( string nServer, string nMap, string nGameName, string nOwnerName, uint32_t nDuration, uint32_t nGameState, string nCreatorName, string nCreatorServer, vector<string> nChatLog ) : CBaseCallable( ), m_Server( nServer ), m_Map( nMap ), m_GameName( nGameName ), m_OwnerName( nOwnerName ), m_Duration( nDuration ), m_GameState( nGameState ), m_CreatorName( nCreatorName ), m_CreatorServer( nCreatorServer ), m_ChatLog( nChatLog ), m_Result( 0 ) { }
+	virtual ~CCallableGameAdd( );
+
+	virtual uint32_t GetResult( )				{ return m_Result; }
+	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
+};
+
+class CCallableGamePlayerAdd : virtual public CBaseCallable
+{
+protected:
+	uint32_t m_GameID;
+	string m_Name;
+	string m_IP;
+	uint32_t m_Spoofed;
+	string m_SpoofedRealm;
+	uint32_t m_Reserved;
+	uint32_t m_LoadingTime;
+	uint32_t m_Left;
+	string m_LeftReason;
+	uint32_t m_Team;
+	uint32_t m_Colour;
+	uint32_t m_Result;
+
+public:
+	CCallableGamePlayerAdd( uint32_t nGameID, string nName, string nIP, uint32_t nSpoofed, string nSpoofedRealm, uint32_t nReserved, uint32_t nLoadingTime, uint32_t nLeft, string nLeftReason, uint32_t nTeam, uint32_t nColour ) : CBaseCallable( ), m_GameID( nGameID ), m_Name( nName ), m_IP( nIP ), m_Spoofed( nSpoofed ), m_SpoofedRealm( nSpoofedRealm ), m_Reserved( nReserved ), m_LoadingTime( nLoadingTime ), m_Left( nLeft ), m_LeftReason( nLeftReason ), m_Team( nTeam ), m_Colour( nColour ), m_Result( 0 ) { }
+	virtual ~CCallableGamePlayerAdd( );
+
+	virtual uint32_t GetResult( )				{ return m_Result; }
+	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
+};
+
+class CCallableGamePlayerSummaryCheck : virtual public CBaseCallable
+{
+protected:
+	string m_Name;
+	CDBGamePlayerSummary *m_Result;
+	uint32_t m_Season;
+
+public:
+	CCallableGamePlayerSummaryCheck( string nName, uint32_t nSeason ) : CBaseCallable( ), m_Season( nSeason ), m_Name( nName ), m_Result( NULL ) { }
+	virtual ~CCallableGamePlayerSummaryCheck( );
+
+	virtual string GetName( )								{ return m_Name; }
+	virtual string SetName( string nName )					{ m_Name = nName; }
+	virtual CDBGamePlayerSummary *GetResult( )				{ return m_Result; }
+	virtual void SetResult( CDBGamePlayerSummary *nResult )	{ m_Result = nResult; }
+	virtual uint32_t GetSeason()								{ return m_Season; }
+};
+
+class CCallableDotAGameAdd : virtual public CBaseCallable
+{
+protected:
+	uint32_t m_GameID;
+	uint32_t m_Winner;
+	uint32_t m_Min;
+	uint32_t m_Sec;
+	uint32_t m_Result;
+
+public:
+	CCallableDotAGameAdd( uint32_t nGameID, uint32_t nWinner, uint32_t nMin, uint32_t nSec ) : CBaseCallable( ), m_GameID( nGameID ), m_Winner( nWinner ), m_Min( nMin ), m_Sec( nSec ), m_Result( 0 ) { }
+	virtual ~CCallableDotAGameAdd( );
+
+	virtual uint32_t GetResult( )				{ return m_Result; }
+	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
+};
+
+class CCallableDotAEventAdd : virtual public CBaseCallable
+{
+protected:
+	uint32_t m_GameID;
+	string	 m_GameName;
+	string 	 m_Killer;
+	string 	 m_Victim;
+	uint32_t m_Result;
+	uint32_t m_KillerColour;
+	uint32_t m_VictimColour;
+
+public:
+	CCallableDotAEventAdd( uint32_t nGameID, string nGameName, string nKiller, string nVictim, uint32_t kcolour, uint32_t vcolour ) : CBaseCallable( ), m_GameID( nGameID), m_GameName( nGameName ), m_Killer( nKiller ), m_Victim( nVictim ), m_KillerColour( kcolour ), m_VictimColour( vcolour ), m_Result( 0 ) { }
+	virtual ~CCallableDotAEventAdd( );
+
+	virtual uint32_t GetGameID( )				{ return m_GameID; }
+	virtual string GetGameName( )				{ return m_GameName; }
+	virtual string GetKiller( )					{ return m_Killer; }
+	virtual string GetVictim( )					{ return m_Victim; }
+	virtual uint32_t GetKillerColour( )			{ return m_KillerColour; }
+	virtual uint32_t GetVictimColour( )			{ return m_VictimColour; }
+	virtual uint32_t GetResult( )				{ return m_Result; }
+	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
+};
+
+
+class CCallableDotAPlayerAdd : virtual public CBaseCallable
+{
+protected:
+	uint32_t m_GameID;
+	uint32_t m_Colour;
+	uint32_t m_Kills;
+	uint32_t m_Deaths;
+	uint32_t m_CreepKills;
+	uint32_t m_CreepDenies;
+	uint32_t m_Assists;
+	uint32_t m_Gold;
+	uint32_t m_NeutralKills;
+	string m_Item1;
+	string m_Item2;
+	string m_Item3;
+	string m_Item4;
+	string m_Item5;
+	string m_Item6;
+	string m_Hero;
+	uint32_t m_NewColour;
+	uint32_t m_TowerKills;
+	uint32_t m_RaxKills;
+	uint32_t m_CourierKills;
+	uint32_t m_Result;
+	
+	// nordicleague
+	
+	string 	 m_Name;
+	uint32_t m_Outcome;
+	uint32_t m_Level;
+	uint32_t m_Apm;
+
+public:
+	CCallableDotAPlayerAdd( uint32_t nGameID, string nName, uint32_t nColour, uint32_t nKills, uint32_t nDeaths, uint32_t nCreepKills, uint32_t nCreepDenies, uint32_t nAssists, uint32_t nGold, uint32_t nNeutralKills, string nItem1, string nItem2, string nItem3, string nItem4, string nItem5, string nItem6, string nHero, uint32_t nNewColour, uint32_t nTowerKills, uint32_t nRaxKills, uint32_t nCourierKills, uint32_t nOutcome, uint32_t nLevel, uint32_t nApm ) : CBaseCallable( ), m_GameID( nGameID ), m_Name( nName ), m_Colour( nColour ), m_Kills( nKills ), m_Deaths( nDeaths ), m_CreepKills( nCreepKills ), m_CreepDenies( nCreepDenies ), m_Assists( nAssists ), m_Gold( nGold ), m_NeutralKills( nNeutralKills ), m_Item1( nItem1 ), m_Item2( nItem2 ), m_Item3( nItem3 ), m_Item4( nItem4 ), m_Item5( nItem5 ), m_Item6( nItem6 ), m_Hero( nHero ), m_NewColour( nNewColour ), m_TowerKills( nTowerKills ), m_RaxKills( nRaxKills ), m_CourierKills( nCourierKills ), m_Outcome( nOutcome ), m_Level ( nLevel ), m_Apm ( nApm), m_Result( 0 ) { }
+	virtual ~CCallableDotAPlayerAdd( );
+
+	virtual uint32_t GetResult( )				{ return m_Result; }
+	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
+};
+
+class CCallableDotAPlayerSummaryCheck : virtual public CBaseCallable
+{
+protected:
+	string m_Name;
+	uint32_t m_Season;
+	CDBDotAPlayerSummary *m_Result;
+
+public:
+	CCallableDotAPlayerSummaryCheck( string nName, uint32_t nSeason ) : CBaseCallable( ), m_Name( nName ), m_Season( nSeason ), m_Result( NULL ) { }
+	virtual ~CCallableDotAPlayerSummaryCheck( );
+
+	virtual string GetName( )						{ return m_Name; }
+	virtual string SetName( string nName )					{ m_Name = nName; }
+	virtual CDBDotAPlayerSummary *GetResult( )				{ return m_Result; }
+	virtual void SetResult( CDBDotAPlayerSummary *nResult )			{ m_Result = nResult; }
+	virtual uint32_t GetSeason()								{ return m_Season; }
+};
+
+class CCallableDownloadAdd : virtual public CBaseCallable
+{
+protected:
+	string m_Map;
+	uint32_t m_MapSize;
+	string m_Name;
+	string m_IP;
+	uint32_t m_Spoofed;
+	string m_SpoofedRealm;
+	uint32_t m_DownloadTime;
+	bool m_Result;
+
+public:
+	CCallableDownloadAdd( string nMap, uint32_t nMapSize, string nName, string nIP, uint32_t nSpoofed, string nSpoofedRealm, uint32_t nDownloadTime ) : CBaseCallable( ), m_Map( nMap ), m_MapSize( nMapSize ), m_Name( nName ), m_IP( nIP ), m_Spoofed( nSpoofed ), m_SpoofedRealm( nSpoofedRealm ), m_DownloadTime( nDownloadTime ), m_Result( false ) { }
+	virtual ~CCallableDownloadAdd( );
+
+	virtual bool GetResult( )				{ return m_Result; }
+	virtual void SetResult( bool nResult )	{ m_Result = nResult; }
+};
+
+class CCallableScoreCheck : virtual public CBaseCallable
+{
+protected:
+	string m_Category;
+	string m_Name;
+	string m_Server;
+	double m_Result;
+	uint32_t m_Season;
+	
+	// nordicleague
+	
+	CDBGamePlayerSummary *m_GamePlayer;
+
+public:
+	CCallableScoreCheck( string nCategory, string nName, string nServer, uint32_t nSeason ) : CBaseCallable( ), m_Season( nSeason ), m_Category( nCategory ), m_Name( nName ), m_Server( nServer ), m_Result( 0.0 ), m_GamePlayer( NULL ) { }
+	virtual ~CCallableScoreCheck( );
+
+	virtual string GetName( )										{ return m_Name; }
+	virtual double GetResult( )										{ return m_Result; }
+	virtual void SetResult( double nResult )						{ m_Result = nResult; }
+	virtual uint32_t GetSeason()									{ return m_Season; }
+	
+	// nordicleague
+	
+	virtual CDBGamePlayerSummary *GetPlayerSummary( )				{ return m_GamePlayer; }
+	virtual void SetPlayerSummary( CDBGamePlayerSummary *nSummary )	{ m_GamePlayer = nSummary; }
+};
+
+class CCallableW3MMDPlayerAdd : virtual public CBaseCallable
+{
+protected:
+	string m_Category;
+	uint32_t m_GameID;
+	uint32_t m_PID;
+	string m_Name;
+	string m_Flag;
+	uint32_t m_Leaver;
+	uint32_t m_Practicing;
+	uint32_t m_Result;
+
+public:
+	CCallableW3MMDPlayerAdd( string nCategory, uint32_t nGameID, uint32_t nPID, string nName, string nFlag, uint32_t nLeaver, uint32_t nPracticing ) : CBaseCallable( ), m_Category( nCategory ), m_GameID( nGameID ), m_PID( nPID ), m_Name( nName ), m_Flag( nFlag ), m_Leaver( nLeaver ), m_Practicing( nPracticing ), m_Result( 0 ) { }
+	virtual ~CCallableW3MMDPlayerAdd( );
+
+	virtual uint32_t GetResult( )				{ return m_Result; }
+	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
+};
+
+class CCallableW3MMDVarAdd : virtual public CBaseCallable
+{
+protected:
+	uint32_t m_GameID;
+	map<VarP,int32_t> m_VarInts;
+	map<VarP,double> m_VarReals;
+	map<VarP,string> m_VarStrings;
+
+	enum ValueType {
+		VALUETYPE_INT = 1,
+		VALUETYPE_REAL = 2,
+		VALUETYPE_STRING = 3
+	};
+
+	ValueType m_ValueType;
+	bool m_Result;
+
+public:
+	CCallableW3MMDVarAdd( uint32_t nGameID, map<VarP,int32_t> nVarInts ) : CBaseCallable( ), m_GameID( nGameID ), m_VarInts( nVarInts ), m_ValueType( VALUETYPE_INT ), m_Result( false ) { }
+	CCallableW3MMDVarAdd( uint32_t nGameID, map<VarP,double> nVarReals ) : CBaseCallable( ), m_GameID( nGameID ), m_VarReals( nVarReals ), m_ValueType( VALUETYPE_REAL ), m_Result( false ) { }
+	CCallableW3MMDVarAdd( uint32_t nGameID, map<VarP,string> nVarStrings ) : CBaseCallable( ), m_GameID( nGameID ), m_VarStrings( nVarStrings ), m_ValueType( VALUETYPE_STRING ), m_Result( false ) { }
+	virtual ~CCallableW3MMDVarAdd( );
+
+	virtual bool GetResult( )				{ return m_Result; }
+	virtual void SetResult( bool nResult )	{ m_Result = nResult; }
+};
+
+// nordicleague
+
+class CCallableUpdateGameInfo : virtual public CBaseCallable
+{
+protected:
+	string m_Name;
+	uint32_t m_Players;
+	bool m_Public;
+	bool m_Result;
+	vector<string> m_Slots;
+
+public:
+	CCallableUpdateGameInfo( string name, uint32_t players, bool ispublic, vector<string> slots ) : CBaseCallable( ), m_Name( name ), m_Players( players ), m_Public( ispublic ), m_Slots( slots ),  m_Result( false ) { }
+	virtual ~CCallableUpdateGameInfo( );
+
+	virtual bool GetResult( )					{ return m_Result; }
+	virtual void SetResult( bool nResult )		{ m_Result = nResult; }
+	virtual void SetName( string name ) 		{ m_Name = name; }
+	virtual void SetPlayers( uint32_t players ) { m_Players = players; }
+	virtual void SetPublic( bool ispublic ) 	{ m_Public = ispublic; }
+};
+
+class CCallableCountrySkipList : virtual public CBaseCallable
+{
+protected:
+	set<string> m_Result;
+
+public:
+	CCallableCountrySkipList( ) : CBaseCallable( ) { }
+	virtual ~CCallableCountrySkipList( );
+
+	virtual set<string> GetResult( )					{ return m_Result; }
+	virtual void SetResult( set<string> nResult )	{ m_Result = nResult; }
+};
+
+class CCallableVouchList : virtual public CBaseCallable
+{
+protected:
+	set<VouchPair> m_Result;
+
+public:
+	CCallableVouchList( ) : CBaseCallable( ) { }
+	virtual ~CCallableVouchList( );
+
+	virtual set<VouchPair> GetResult( )					{ return m_Result; }
+	virtual void SetResult( set<VouchPair> nResult )	{ m_Result = nResult; }
+};
+
+//
+// CDBBan
+//
+
+class CDBBan
+{
+private:
+	uint32_t m_ID;			// the database id, 0 if the ban was added locally and hasn't been fetched from the database yet
+	string m_Server;
+	string m_Name;
+	string m_IP;
+	string m_Date;
+	string m_GameName;
+	string m_Admin;
+	string m_Reason;
+	
+	// nordicleague
+	
+	bool m_IPBan;
+	string m_Expires;
+
+public:
+	CDBBan( string nServer, string nName, string nIP, string nDate, string nGameName, string nAdmin, string nReason );
+	
+	// nordicleague
+	
+	CDBBan( string nServer, string nName, string nIP, string nDate, string nGameName, string nAdmin, string nReason, string nExpires );
+	CDBBan( string nServer, string nName, string nIP, string nDate, string nGameName, string nAdmin, string nReason, uint32_t nIPBan );
+	CDBBan( string nServer, string nName, string nIP, string nDate, string nGameName, string nAdmin, string nReason, uint32_t nIPBan, string nExpires );
+	~CDBBan( );
+
+	uint32_t GetID( )		{ return m_ID; }
+	string GetServer( )		{ return m_Server; }
+	string GetName( )		{ return m_Name; }
+	string GetIP( )			{ return m_IP; }
+	string GetDate( )		{ return m_Date; }
+	string GetGameName( )	{ return m_GameName; }
+	string GetAdmin( )		{ return m_Admin; }
+	string GetReason( )		{ return m_Reason; }
+	
+	// nordicleague
+	
+	bool   GetIPBan( )		{ return m_IPBan; }
+	bool   IsTemporary()	{ return m_Expires.empty() ? false : true; }
+	string GetExpires()		{ return m_Expires; }
+
+	void SetID( uint32_t nID )	{ m_ID = nID; }
+};
+
+//
+// CDBGame
+//
+
+class CDBGame
+{
+private:
+	uint32_t m_ID;
+	string m_Server;
+	string m_Map;
+	string m_DateTime;
+	string m_GameName;
+	string m_OwnerName;
+	uint32_t m_Duration;
+
+public:
+	CDBGame( uint32_t nID, string nServer, string nMap, string nDateTime, string nGameName, string nOwnerName, uint32_t nDuration );
+	~CDBGame( );
+
+	uint32_t GetID( )		{ return m_ID; }
+	string GetServer( )		{ return m_Server; }
+	string GetMap( )		{ return m_Map; }
+	string GetDateTime( )	{ return m_DateTime; }
+	string GetGameName( )	{ return m_GameName; }
+	string GetOwnerName( )	{ return m_OwnerName; }
+	uint32_t GetDuration( )	{ return m_Duration; }
+
+	void SetDuration( uint32_t nDuration )	{ m_Duration = nDuration; }
+};
+
+//
+// CDBGamePlayer
+//
+
+class CDBGamePlayer
+{
+private:
+	uint32_t m_ID;
+	uint32_t m_GameID;
+	string m_Name;
+	string m_IP;
+	uint32_t m_Spoofed;
+	string m_SpoofedRealm;
+	uint32_t m_Reserved;
+	uint32_t m_LoadingTime;
+	uint32_t m_Left;
+	string m_LeftReason;
+	uint32_t m_Team;
+	uint32_t m_Colour;
+
+public:
+	CDBGamePlayer( uint32_t nID, uint32_t nGameID, string nName, string nIP, uint32_t nSpoofed, string nSpoofedRealm, uint32_t nReserved, uint32_t nLoadingTime, uint32_t nLeft, string nLeftReason, uint32_t nTeam, uint32_t nColour );
+	~CDBGamePlayer( );
+
+	uint32_t GetID( )			{ return m_ID; }
+	uint32_t GetGameID( )		{ return m_GameID; }
+	string GetName( )			{ return m_Name; }
+	string GetIP( )				{ return m_IP; }
+	uint32_t GetSpoofed( )		{ return m_Spoofed; }
+	string GetSpoofedRealm( )	{ return m_SpoofedRealm; }
+	uint32_t GetReserved( )		{ return m_Reserved; }
+	uint32_t GetLoadingTime( )	{ return m_LoadingTime; }
+	uint32_t GetLeft( )			{ return m_Left; }
+	string GetLeftReason( )		{ return m_LeftReason; }
+	uint32_t GetTeam( )			{ return m_Team; }
+	uint32_t GetColour( )		{ return m_Colour; }
+
+	void SetLoadingTime( uint32_t nLoadingTime )	{ m_LoadingTime = nLoadingTime; }
+	void SetLeft( uint32_t nLeft )					{ m_Left = nLeft; }
+	void SetLeftReason( string nLeftReason )		{ m_LeftReason = nLeftReason; }
+};
+
+//
+// CDBGamePlayerSummary
+//
+
+class CDBGamePlayerSummary
+{
+private:
+	string m_Server;
+	string m_Name;
+	string m_FirstGameDateTime;		// datetime of first game played
+	string m_LastGameDateTime;		// datetime of last game played
+	uint32_t m_TotalGames;			// total number of games played
+	uint32_t m_MinLoadingTime;		// minimum loading time in milliseconds (this could be skewed because different maps have different load times)
+	uint32_t m_AvgLoadingTime;		// average loading time in milliseconds (this could be skewed because different maps have different load times)
+	uint32_t m_MaxLoadingTime;		// maximum loading time in milliseconds (this could be skewed because different maps have different load times)
+	uint32_t m_MinLeftPercent;		// minimum time at which the player left the game expressed as a percentage of the game duration (0-100)
+	uint32_t m_AvgLeftPercent;		// average time at which the player left the game expressed as a percentage of the game duration (0-100)
+	uint32_t m_MaxLeftPercent;		// maximum time at which the player left the game expressed as a percentage of the game duration (0-100)
+	uint32_t m_MinDuration;			// minimum game duration in seconds
+	uint32_t m_AvgDuration;			// average game duration in seconds
+	uint32_t m_MaxDuration;			// maximum game duration in seconds
+	bool	 m_Vouched;
+	string	 m_VouchedBy;
+	string	m_AliasName;
+	bool	m_HasAlias;
+	uint32_t m_Season;
+	uint32_t m_AllTotalGames;			// total number of games played all season
+
+public:
+	CDBGamePlayerSummary( string nServer, string nName, string nFirstGameDateTime, string nLastGameDateTime, uint32_t nTotalGames, uint32_t nMinLoadingTime, uint32_t nAvgLoadingTime, uint32_t nMaxLoadingTime, uint32_t nMinLeftPercent, uint32_t nAvgLeftPercent, uint32_t nMaxLeftPercent, uint32_t nMinDuration, uint32_t nAvgDuration, uint32_t nMaxDuration );
+	CDBGamePlayerSummary( string nServer, string nName, string nFirstGameDateTime, string nLastGameDateTime, uint32_t nTotalGames, uint32_t nMinLoadingTime, uint32_t nAvgLoadingTime, uint32_t nMaxLoadingTime, uint32_t nMinLeftPercent, uint32_t nAvgLeftPercent, uint32_t nMaxLeftPercent, uint32_t nMinDuration, uint32_t nAvgDuration, uint32_t nMaxDuration, bool nVouched, string nVouchedBy );
+	~CDBGamePlayerSummary( );
+
+	string GetServer( )			{ return m_Server; }
+	string GetName( )			{ return m_Name; }
+	string GetAlias( )			{ return m_AliasName; }
+	string GetFirstGameDateTime( )		{ return m_FirstGameDateTime; }
+	string GetLastGameDateTime( )		{ return m_LastGameDateTime; }
+	uint32_t GetTotalGames( )		{ return m_TotalGames; }
+	uint32_t GetMinLoadingTime( )		{ return m_MinLoadingTime; }
+	uint32_t GetAvgLoadingTime( )		{ return m_AvgLoadingTime; }
+	uint32_t GetMaxLoadingTime( )		{ return m_MaxLoadingTime; }
+	uint32_t GetMinLeftPercent( )		{ return m_MinLeftPercent; }
+	uint32_t GetAvgLeftPercent( )		{ return m_AvgLeftPercent; }
+	uint32_t GetMaxLeftPercent( )		{ return m_MaxLeftPercent; }
+	uint32_t GetMinDuration( )		{ return m_MinDuration; }
+	uint32_t GetAvgDuration( )		{ return m_AvgDuration; }
+	uint32_t GetMaxDuration( )		{ return m_MaxDuration; }
+	bool	 IsVouched( )			{ return m_Vouched; }
+	string	 GetVouchedBy( )		{ return m_VouchedBy; }
+	void	SetVouched(bool nVouched) 	{ m_Vouched = nVouched; }
+	void	SetVouchedBy(string nName) 	{ m_VouchedBy = nName; }
+	void SetAlias( string nName )		{ m_AliasName = nName; }
+	bool HasAlias( )			{ return m_HasAlias; }
+	bool HasAlias( bool nHasAlias )			{ m_HasAlias = nHasAlias; }
+	
+	uint32_t GetAllTotalGames( )		{ return m_AllTotalGames; }
+	void SetAllTotalGames( uint32_t nGames )		{ m_AllTotalGames = nGames; }
+};
+
+//
+// CDBDotAGame
+//
+
+class CDBDotAGame
+{
+private:
+	uint32_t m_ID;
+	uint32_t m_GameID;
+	uint32_t m_Winner;
+	uint32_t m_Min;
+	uint32_t m_Sec;
+
+public:
+	CDBDotAGame( uint32_t nID, uint32_t nGameID, uint32_t nWinner, uint32_t nMin, uint32_t nSec );
+	~CDBDotAGame( );
+
+	uint32_t GetID( )		{ return m_ID; }
+	uint32_t GetGameID( )	{ return m_GameID; }
+	uint32_t GetWinner( )	{ return m_Winner; }
+	uint32_t GetMin( )		{ return m_Min; }
+	uint32_t GetSec( )		{ return m_Sec; }
+};
+
+//
+// CDBDotAPlayer
+//
+
+class CDBDotAPlayer
+{
+private:
+	uint32_t m_ID;
+	uint32_t m_GameID;
+	uint32_t m_Colour;
+	uint32_t m_Kills;
+	uint32_t m_Deaths;
+	uint32_t m_CreepKills;
+	uint32_t m_CreepDenies;
+	uint32_t m_Assists;
+	uint32_t m_Gold;
+	uint32_t m_NeutralKills;
+	string m_Items[6];
+	string m_Hero;
+	uint32_t m_NewColour;
+	uint32_t m_TowerKills;
+	uint32_t m_RaxKills;
+	uint32_t m_CourierKills;
+	
+	// nordicleague
+	string 	 m_Name;
+	uint32_t m_Rank;
+	uint32_t m_Score;
+	uint32_t m_Outcome;
+	uint32_t m_Level;
+	uint32_t m_Apm;
+
+public:
+	CDBDotAPlayer( );
+	CDBDotAPlayer( uint32_t nID, string nName, uint32_t nGameID, uint32_t nColour, uint32_t nKills, uint32_t nDeaths, uint32_t nCreepKills, uint32_t nCreepDenies, uint32_t nAssists, uint32_t nGold, uint32_t nNeutralKills, string nItem1, string nItem2, string nItem3, string nItem4, string nItem5, string nItem6, string nHero, uint32_t nNewColour, uint32_t nTowerKills, uint32_t nRaxKills, uint32_t nCourierKills, uint32_t nOutcome, uint32_t nLevel, uint32_t nApm );
+	CDBDotAPlayer( uint32_t nID, string nName, uint32_t nGameID, uint32_t nColour, uint32_t nKills, uint32_t nDeaths, uint32_t nCreepKills, uint32_t nCreepDenies, uint32_t nAssists, uint32_t nGold, uint32_t nNeutralKills, string nItem1, string nItem2, string nItem3, string nItem4, string nItem5, string nItem6, string nHero, uint32_t nNewColour, uint32_t nTowerKills, uint32_t nRaxKills, uint32_t nCourierKills, uint32_t nRank, uint32_t nScore, uint32_t nOutcome, uint32_t nLevel, uint32_t nApm );
+	~CDBDotAPlayer( );
+
+	uint32_t GetID( )			{ return m_ID; }
+	uint32_t GetGameID( )		{ return m_GameID; }
+	uint32_t GetColour( )		{ return m_Colour; }
+	uint32_t GetKills( )		{ return m_Kills; }
+	uint32_t GetDeaths( )		{ return m_Deaths; }
+	uint32_t GetCreepKills( )	{ return m_CreepKills; }
+	uint32_t GetCreepDenies( )	{ return m_CreepDenies; }
+	uint32_t GetAssists( )		{ return m_Assists; }
+	uint32_t GetGold( )			{ return m_Gold; }
+	uint32_t GetNeutralKills( )	{ return m_NeutralKills; }
+	string GetItem( unsigned int i );
+	string GetHero( )			{ return m_Hero; }
+	uint32_t GetNewColour( )	{ return m_NewColour; }
+	uint32_t GetTowerKills( )	{ return m_TowerKills; }
+	uint32_t GetRaxKills( )		{ return m_RaxKills; }
+	uint32_t GetCourierKills( )	{ return m_CourierKills; }
+	
+	// nordicleague
+	
+	uint32_t GetRank( )			{ return m_Rank; }
+	uint32_t GetScore( )		{ return m_Score; }
+	uint32_t GetOutcome()		{ return m_Outcome; }
+	string 	 GetName()			{ return m_Name; }
+	uint32_t GetLevel()			{ return m_Level; }
+	uint32_t GetApm() 			{ return m_Apm; }
+	
+	
+
+	void SetColour( uint32_t nColour )				{ m_Colour = nColour; }
+	void SetKills( uint32_t nKills )				{ m_Kills = nKills; }
+	void SetDeaths( uint32_t nDeaths )				{ m_Deaths = nDeaths; }
+	void SetCreepKills( uint32_t nCreepKills )		{ m_CreepKills = nCreepKills; }
+	void SetCreepDenies( uint32_t nCreepDenies )	{ m_CreepDenies = nCreepDenies; }
+	void SetAssists( uint32_t nAssists )			{ m_Assists = nAssists; }
+	void SetGold( uint32_t nGold )					{ m_Gold = nGold; }
+	void SetNeutralKills( uint32_t nNeutralKills )	{ m_NeutralKills = nNeutralKills; }
+	void SetItem( unsigned int i, string item );
+	void SetHero( string nHero )					{ m_Hero = nHero; }
+	void SetNewColour( uint32_t nNewColour )		{ m_NewColour = nNewColour; }
+	void SetTowerKills( uint32_t nTowerKills )		{ m_TowerKills = nTowerKills; }
+	void SetRaxKills( uint32_t nRaxKills )			{ m_RaxKills = nRaxKills; }
+	void SetCourierKills( uint32_t nCourierKills )	{ m_CourierKills = nCourierKills; }
+	
+	// nordicleague
+	
+	void SetRank( uint32_t nRank )					{ m_Rank = nRank; }
+	void SetScore( uint32_t nScore )				{ m_Score = nScore; }
+	void SetOutcome( uint32_t nOutcome )			{ m_Outcome = nOutcome; }
+	void SetName( string nName )					{ m_Name = nName; }
+	void SetLevel( uint32_t nLevel )				{ m_Level = nLevel; } 
+	void SetApm( uint32_t nApm )					{ m_Apm = nApm; }
+};
+
+//
+// CDBDotAPlayerSummary
+//
+
+class CDBDotAPlayerSummary
+{
+private:
+	string m_Server;
+	string m_Name;
+	uint32_t m_TotalGames;			// total number of dota games played
+	uint32_t m_TotalWins;			// total number of dota games won
+	uint32_t m_TotalLosses;			// total number of dota games lost
+	uint32_t m_TotalKills;			// total number of hero kills
+	uint32_t m_TotalDeaths;			// total number of deaths
+	uint32_t m_TotalCreepKills;		// total number of creep kills
+	uint32_t m_TotalCreepDenies;	// total number of creep denies
+	uint32_t m_TotalAssists;		// total number of assists
+	uint32_t m_TotalNeutralKills;	// total number of neutral kills
+	uint32_t m_TotalTowerKills;		// total number of tower kills
+	uint32_t m_TotalRaxKills;		// total number of rax kills
+	uint32_t m_TotalCourierKills;	// total number of courier kills
+	
+	// nordicleague
+	
+	uint32_t m_Rank;
+	double 	 m_Score;
+	uint32_t m_Streak;
+
+public:
+	CDBDotAPlayerSummary( string nServer, string nName, uint32_t nTotalGames, uint32_t nTotalWins, uint32_t nTotalLosses, uint32_t nTotalKills, uint32_t nTotalDeaths, uint32_t nTotalCreepKills, uint32_t nTotalCreepDenies, uint32_t nTotalAssists, uint32_t nTotalNeutralKills, uint32_t nTotalTowerKills, uint32_t nTotalRaxKills, uint32_t nTotalCourierKills );
+	CDBDotAPlayerSummary( string nServer, string nName, uint32_t nTotalGames, uint32_t nTotalWins, uint32_t nTotalLosses, uint32_t nTotalKills, uint32_t nTotalDeaths, uint32_t nTotalCreepKills, uint32_t nTotalCreepDenies, uint32_t nTotalAssists, uint32_t nTotalNeutralKills, uint32_t nTotalTowerKills, uint32_t nTotalRaxKills, uint32_t nTotalCourierKills, uint32_t nRank, double nScore );
+	CDBDotAPlayerSummary( string nServer, string nName, uint32_t nTotalGames, uint32_t nTotalWins, uint32_t nTotalLosses, uint32_t nTotalKills, uint32_t nTotalDeaths, uint32_t nTotalCreepKills, uint32_t nTotalCreepDenies, uint32_t nTotalAssists, uint32_t nTotalNeutralKills, uint32_t nTotalTowerKills, uint32_t nTotalRaxKills, uint32_t nTotalCourierKills, uint32_t nRank, double nScore, uint32_t nStreak );
+	~CDBDotAPlayerSummary( );
+
+	string GetServer( )					{ return m_Server; }
+	string GetName( )					{ return m_Name; }
+	uint32_t GetTotalGames( )			{ return m_TotalGames; }
+	uint32_t GetTotalWins( )			{ return m_TotalWins; }
+	uint32_t GetTotalLosses( )			{ return m_TotalLosses; }
+	uint32_t GetTotalKills( )			{ return m_TotalKills; }
+	uint32_t GetTotalDeaths( )			{ return m_TotalDeaths; }
+	uint32_t GetTotalCreepKills( )		{ return m_TotalCreepKills; }
+	uint32_t GetTotalCreepDenies( )		{ return m_TotalCreepDenies; }
+	uint32_t GetTotalAssists( )			{ return m_TotalAssists; }
+	uint32_t GetTotalNeutralKills( )	{ return m_TotalNeutralKills; }
+	uint32_t GetTotalTowerKills( )		{ return m_TotalTowerKills; }
+	uint32_t GetTotalRaxKills( )		{ return m_TotalRaxKills; }
+	uint32_t GetTotalCourierKills( )	{ return m_TotalCourierKills; }
+	
+	// nordicleague
+	
+	uint32_t GetRank( )					{ return m_Rank; }
+	double 	 GetScore( )				{ return m_Score; }
+	uint32_t GetStreak( )				{ return m_Streak; }
+
+	float GetAvgKills( )				{ return m_TotalGames > 0 ? (float)m_TotalKills / m_TotalGames : 0; }
+	float GetAvgDeaths( )				{ return m_TotalGames > 0 ? (float)m_TotalDeaths / m_TotalGames : 0; }
+	float GetAvgCreepKills( )			{ return m_TotalGames > 0 ? (float)m_TotalCreepKills / m_TotalGames : 0; }
+	float GetAvgCreepDenies( )			{ return m_TotalGames > 0 ? (float)m_TotalCreepDenies / m_TotalGames : 0; }
+	float GetAvgAssists( )				{ return m_TotalGames > 0 ? (float)m_TotalAssists / m_TotalGames : 0; }
+	float GetAvgNeutralKills( )			{ return m_TotalGames > 0 ? (float)m_TotalNeutralKills / m_TotalGames : 0; }
+	float GetAvgTowerKills( )			{ return m_TotalGames > 0 ? (float)m_TotalTowerKills / m_TotalGames : 0; }
+	float GetAvgRaxKills( )				{ return m_TotalGames > 0 ? (float)m_TotalRaxKills / m_TotalGames : 0; }
+	float GetAvgCourierKills( )			{ return m_TotalGames > 0 ? (float)m_TotalCourierKills / m_TotalGames : 0; }
+};
+
+
+// nordicleague
+
+
+class CCallableRegisterPlayerAdd : virtual public CBaseCallable
+{
+protected:
+	string m_Name, m_Email, m_IP;
+	uint32_t m_Result;
+
+public:
+	CCallableRegisterPlayerAdd( string nName, string nEmail, string nIP) : CBaseCallable( ), m_Name( nName ), m_IP( nIP ),m_Email( nEmail ), m_Result( 0 ) { }
+	virtual ~CCallableRegisterPlayerAdd( );
+
+	virtual string GetUser() { return m_Name; }
+	virtual string GetMail() { return m_Email; }
+
+	virtual uint32_t GetResult( )				{ return m_Result; }
+	virtual void SetResult( uint32_t nResult )	{ m_Result = nResult; }
+};
+
+//
+// CDBLastSeenPlayer
+//
+
+class CDBLastSeenPlayer
+{
+private:
+	bool 		m_Seen;
+	string 		m_Name;
+	string 		m_Date;
+	string 		m_LastGame;
+	string 		m_LastHero;
+	uint32_t 	m_LastTeam;
+	uint32_t 	m_LastOutcome;
+	double 		m_LastGain;
+	uint32_t 	m_Kills;
+	uint32_t 	m_Deaths;
+	uint32_t 	m_Assists;
+
+public:
+	CDBLastSeenPlayer( string nName );
+	CDBLastSeenPlayer( bool nSeen, string nName );
+	CDBLastSeenPlayer( bool nSeen, string nName, string nDate, string nLastGame, string nLastHero, uint32_t nLastTeam, uint32_t nLastOutcome, double nLastGain, uint32_t nKills, uint32_t nDeaths, uint32_t nAssists );
+	~CDBLastSeenPlayer( );
+
+	bool 		Seen( )				{ return m_Seen; }
+	string 		GetName( )			{ return m_Name; }
+	string 		GetDate( )			{ return m_Date; }
+	string 		GetLastGame( )		{ return m_LastGame; }
+	string 		GetLastHero( )		{ return m_LastHero; }
+	uint32_t 	GetLastTeam( )		{ return m_LastTeam; }
+	uint32_t 	GetLastOutcome( )	{ return m_LastOutcome; }
+	double 		GetLastGain( )		{ return m_LastGain; }
+	uint32_t 	GetKills( )			{ return m_Kills; }
+	uint32_t 	GetDeaths( )		{ return m_Deaths; }
+	uint32_t 	GetAssists( )		{ return m_Assists; }
+	string		GetKDA()			{ return UTIL_ToString(m_Kills) + "/" + UTIL_ToString(m_Deaths) + "/" + UTIL_ToString(m_Assists); }
+
+};
+
+class CCallableLastSeenPlayer : virtual public CBaseCallable
+{
+protected:
+	string 				m_Name;
+	CDBLastSeenPlayer 	*m_Result;
+
+public:
+	CCallableLastSeenPlayer( string nName ) : CBaseCallable( ), m_Name( nName ), m_Result( 0 ) { }
+	virtual ~CCallableLastSeenPlayer( );
+
+	virtual string 				GetName() 								{ return m_Name; }
+
+	virtual CDBLastSeenPlayer 	*GetResult( )							{ return m_Result; }
+	virtual void 				SetResult( CDBLastSeenPlayer *nResult )	{ m_Result = nResult; }
+};
+
+class CCallableSaveReplay : virtual public CBaseCallable
+{
+protected:
+	CReplay *m_Replay;
+	bool m_Result;
+
+public:
+	CCallableSaveReplay( CReplay *replay ) : CBaseCallable( ), m_Replay( replay ), m_Result( false ) { }
+	virtual ~CCallableSaveReplay( );
+
+	virtual bool GetResult( )					{ return m_Result; }
+	virtual void SetResult( bool nResult )		{ m_Result = nResult; }
+};
+
+#endif
@@ -1,72 +1,104 @@
-/*
-
-   Copyright [2008] [Trevor Hogan]
-
-   Licensed under the Apache License, Version 2.0 (the "License");
-   you may not use this file except in compliance with the License.
-   You may obtain a copy of the License at
-
-       http://www.apache.org/licenses/LICENSE-2.0
-
-   Unless required by applicable law or agreed to in writing, software
-   distributed under the License is distributed on an "AS IS" BASIS,
-   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-   See the License for the specific language governing permissions and
-   limitations under the License.
-
-   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
-
-*/
-
-#ifndef INCLUDES_H
-#define INCLUDES_H
-
-// standard integer sizes for 64 bit compatibility
-
-#ifdef WIN32
- #include "ms_stdint.h"
-#else
- #include <stdint.h>
-#endif
-
-// STL
-
-#include <fstream>
-#include <iostream>
-#include <sstream>
-#include <iomanip>
-#include <algorithm>
-#include <map>
-#include <queue>
-#include <set>
-#include <string>
-#include <vector>
-
-using namespace std;
-
-typedef vector<unsigned char> BYTEARRAY;
-typedef pair<unsigned char,string> PIDPlayer;
-
-// time
-
-uint32_t GetTime( );		// seconds
-uint32_t GetTicks( );		// milliseconds
-
-#ifdef WIN32
- #define MILLISLEEP( x ) Sleep( x )
-#else
- #define MILLISLEEP( x ) usleep( ( x ) * 1000 )
-#endif
-
-// network
-
-#undef FD_SETSIZE
-#define FD_SETSIZE 512
-
-// output
-
-void CONSOLE_Print( string message );
-void DEBUG_Print( string message );
-void DEBUG_Print( BYTEARRAY b );
-
-#endif
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#ifndef INCLUDES_H
+#define INCLUDES_H
+
+// standard integer sizes for 64 bit compatibility
+
+#ifdef WIN32
+ #include "ms_stdint.h"
+#else
+ #include <stdint.h>
+#endif
+
+// STL
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+using namespace std;
+
+typedef vector<unsigned char> BYTEARRAY;
+typedef boost::shared_ptr<const BYTEARRAY> SHAREDBYTEARRAY;		// an immutable byte array shared by reference (e.g. a packet sent to every player)
+typedef pair<unsigned char,string> PIDPlayer;
+
+// time
+
+uint32_t GetTime( );		// seconds
+uint32_t GetTicks( );		// milliseconds
+uint32_t GetMicroTicks( );	// microseconds, wraps around every 71 minutes so only use it for measuring short intervals
+
+#ifdef WIN32
+ #define MILLISLEEP( x ) Sleep( x )
+#else
+ #define MILLISLEEP( x ) usleep( ( x ) * 1000 )
+#endif
+
+// network
+
+#undef FD_SETSIZE
+#define FD_SETSIZE 512
+
+// output
+// messages are written to the console and the log file by a background thread (see logger.h)
+
+enum LogCategory
+{
+	LOGCAT_GENERAL = 0,
+	LOGCAT_NETWORK,
+	LOGCAT_STATS,
+	LOGCAT_DATABASE,
+	LOGCAT_NUMCATEGORIES
+};
+
+enum LogLevel
+{
+	LOGLEVEL_ERROR = 0,
+	LOGLEVEL_WARNING,
+	LOGLEVEL_INFO,
+	LOGLEVEL_DEBUG
+};
+
+extern uint32_t gLogLevels[LOGCAT_NUMCATEGORIES];
+
+// LOG_Print only builds the message if the level is enabled for the category so a disabled message costs a single comparison
+
+#define LOG_ENABLED( category, level ) ( (uint32_t)( level ) <= gLogLevels[category] )
+#define LOG_Print( category, level, message ) do { if( LOG_ENABLED( category, level ) ) LOG_Write( level, message ); } while( 0 )
+
+void CONSOLE_Print( string message );					// LOGCAT_GENERAL at LOGLEVEL_INFO
+void LOG_Write( uint32_t level, string message );
+void LOG_WriteFile( string file, string message );		// appends the message as is to another file (e.g. a packet log) without a timestamp
+void DEBUG_Print( string message );
+void DEBUG_Print( BYTEARRAY b );
+
+#endif
@@ -0,0 +1,294 @@
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#include "ghost.h"
+#include "util.h"
+#include "ipblacklist.h"
+
+#include <stdlib.h>
+
+#include <boost/thread.hpp>
+
+// parses "1.2.3.4" or a wildcard such as "1.2.3.*" or "1.2.*" and returns the prefix length (32 for a full address)
+// returns false if the string isn't an address
+
+static bool ParseAddress( const string &address, uint32_t &ip, uint32_t &length )
+{
+	uint32_t Octets = 0;
+	string :: size_type Start = 0;
+	ip = 0;
+	length = 32;
+
+	while( Start <= address.size( ) )
+	{
+		string :: size_type End = address.find( '.', Start );
+
+		if( End == string :: npos )
+			End = address.size( );
+
+		string Octet = address.substr( Start, End - Start );
+
+		if( Octet == "*" && End == address.size( ) && Octets > 0 )
+		{
+			length = Octets * 8;
+			ip <<= 32 - length;
+			return true;
+		}
+
+		if( Octet.empty( ) || Octet.size( ) > 3 || Octet.find_first_not_of( "1234567890" ) != string :: npos || Octets == 4 )
+			return false;
+
+		uint32_t Value = atoi( Octet.c_str( ) );
+
+		if( Value > 255 )
+			return false;
+
+		ip = ( ip << 8 ) | Value;
+		Octets++;
+		Start = End + 1;
+	}
+
+	return Octets == 4;
+}
+
+bool ParseIPBlock( const string &block, uint32_t &ip, uint32_t &length )
+{
+	string :: size_type Split = block.find( '/' );
+
+	if( Split == string :: npos )
+		return ParseAddress( block, ip, length );
+
+	string LengthString = block.substr( Split + 1 );
+
+	if( !ParseAddress( block.substr( 0, Split ), ip, length ) || length != 32 || LengthString.empty( ) || LengthString.size( ) > 2 || LengthString.find_first_not_of( "1234567890" ) != string :: npos )
+		return false;
+
+	length = atoi( LengthString.c_str( ) );
+
+	if( length > 32 )
+		return false;
+
+	ip = length == 0 ? 0 : ip & ( 0xFFFFFFFF << ( 32 - length ) );
+	return true;
+}
+
+//
+// CIPBlackList
+//
+
+CIPBlackList :: CIPBlackList( )
+{
+	m_NumEntries = 0;
+
+	// the root node
+
+	m_Children.push_back( 0 );
+	m_Children.push_back( 0 );
+	m_Blocked.push_back( 0 );
+}
+
+CIPBlackList :: ~CIPBlackList( )
+{
+
+}
+
+bool CIPBlackList :: Load( string file )
+{
+	m_File = file;
+	ifstream in;
+	in.open( file.c_str( ) );
+
+	if( in.fail( ) )
+	{
+		CONSOLE_Print( "[IPBLACKLIST] error loading IP blacklist file [" + file + "]" );
+		return false;
+	}
+
+	string Line;
+	uint32_t Ignored = 0;
+
+	while( !in.eof( ) )
+	{
+		getline( in, Line );
+
+		// remove spaces and newlines and partial newlines to help fix issues with Windows formatted files on Linux systems
+
+		Line.erase( remove( Line.begin( ), Line.end( ), ' ' ), Line.end( ) );
+		Line.erase( remove( Line.begin( ), Line.end( ), '\r' ), Line.end( ) );
+		Line.erase( remove( Line.begin( ), Line.end( ), '\n' ), Line.end( ) );
+
+		// ignore blank lines and comments
+
+		if( Line.empty( ) || Line[0] == '#' )
+			continue;
+
+		if( AddLine( Line ) )
+			m_NumEntries++;
+		else
+			Ignored++;
+	}
+
+	in.close( );
+
+	CONSOLE_Print( "[IPBLACKLIST] loaded " + UTIL_ToString( m_NumEntries ) + " entries (" + UTIL_ToString( m_Blocked.size( ) ) + " nodes) from IP blacklist file [" + file + "], " + UTIL_ToString( Ignored ) + " invalid lines ignored" );
+	return true;
+}
+
+bool CIPBlackList :: Check( uint32_t ip )
+{
+	uint32_t Node = 0;
+
+	for( int Bit = 31; !m_Blocked[Node]; Bit-- )
+	{
+		if( Bit < 0 || !( Node = m_Children[Node * 2 + ( ( ip >> Bit ) & 1 )] ) )
+			return false;
+	}
+
+	return true;
+}
+
+void CIPBlackList :: AddPrefix( uint32_t ip, uint32_t length )
+{
+	uint32_t Node = 0;
+
+	for( uint32_t i = 0; i < length; i++ )
+	{
+		// if a shorter prefix is already blacklisted there's nothing to add
+
+		if( m_Blocked[Node] )
+			return;
+
+		uint32_t Child = Node * 2 + ( ( ip >> ( 31 - i ) ) & 1 );
+
+		if( !m_Children[Child] )
+		{
+			m_Children[Child] = m_Blocked.size( );
+			m_Children.push_back( 0 );
+			m_Children.push_back( 0 );
+			m_Blocked.push_back( 0 );
+		}
+
+		Node = m_Children[Child];
+	}
+
+	// any longer prefixes below this node are now unreachable but we leave them in place, they don't affect the result
+
+	m_Blocked[Node] = 1;
+}
+
+void CIPBlackList :: AddRange( uint32_t start, uint32_t end )
+{
+	// split the range into the largest aligned blocks that fit inside it
+
+	uint64_t Start = start;
+
+	while( Start <= end )
+	{
+		uint32_t Bits = 0;
+
+		while( Bits < 32 && ( Start & ( ( (uint64_t)2 << Bits ) - 1 ) ) == 0 && Start + ( (uint64_t)2 << Bits ) - 1 <= end )
+			Bits++;
+
+		AddPrefix( (uint32_t)Start, 32 - Bits );
+		Start += (uint64_t)1 << Bits;
+	}
+}
+
+bool CIPBlackList :: AddLine( string line )
+{
+	uint32_t IP;
+	uint32_t Length;
+	string :: size_type Split;
+
+	if( ( Split = line.find( '-' ) ) != string :: npos )
+	{
+		// range
+
+		uint32_t End;
+
+		if( !ParseAddress( line.substr( 0, Split ), IP, Length ) || Length != 32 || !ParseAddress( line.substr( Split + 1 ), End, Length ) || Length != 32 || IP > End )
+			return false;
+
+		AddRange( IP, End );
+	}
+	else
+	{
+		// address, CIDR block or wildcard
+
+		if( !ParseIPBlock( line, IP, Length ) )
+			return false;
+
+		AddPrefix( IP, Length );
+	}
+
+	return true;
+}
+
+//
+// CIPBlackListLoad
+//
+
+CIPBlackListLoad :: CIPBlackListLoad( string nFile )
+{
+	m_File = nFile;
+	m_BlackList = NULL;
+	m_Mutex = new boost::mutex( );
+	m_Ready = false;
+	m_Thread = new boost::thread( boost::ref( *this ) );
+}
+
+CIPBlackListLoad :: ~CIPBlackListLoad( )
+{
+	// wait for the thread to finish in case we're being deleted before the blacklist is ready (e.g. when shutting down)
+
+	m_Thread->join( );
+	delete m_Thread;
+	delete m_Mutex;
+	delete m_BlackList;
+}
+
+bool CIPBlackListLoad :: GetReady( )
+{
+	boost::mutex :: scoped_lock Lock( *m_Mutex );
+	return m_Ready;
+}
+
+CIPBlackList *CIPBlackListLoad :: TakeBlackList( )
+{
+	boost::mutex :: scoped_lock Lock( *m_Mutex );
+	CIPBlackList *BlackList = m_BlackList;
+	m_BlackList = NULL;
+	return BlackList;
+}
+
+void CIPBlackListLoad :: operator( )( )
+{
+	CIPBlackList *BlackList = new CIPBlackList( );
+
+	if( !BlackList->Load( m_File ) )
+	{
+		delete BlackList;
+		BlackList = NULL;
+	}
+
+	boost::mutex :: scoped_lock Lock( *m_Mutex );
+	m_BlackList = BlackList;
+	m_Ready = true;
+}
@@ -0,0 +1,89 @@
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#ifndef IPBLACKLIST_H
+#define IPBLACKLIST_H
+
+// parses an address (1.2.3.4), a CIDR block (1.2.3.0/24) or a wildcard (1.2.3.* or 1.2.*) into the block's first address (in host byte order) and prefix length
+// returns false if the string isn't one of these
+
+bool ParseIPBlock( const string &block, uint32_t &ip, uint32_t &length );
+
+//
+// CIPBlackList
+//
+
+// the IP blacklist is compiled into a binary trie of address prefixes so checking an address takes at most 32 steps no matter how many entries there are
+// each line of the blacklist file can be an address (1.2.3.4), a CIDR block (1.2.3.0/24), a wildcard (1.2.3.* or 1.2.*) or a range (1.2.3.4-1.2.3.200)
+// a blacklist is never modified once it's loaded, CGHost loads a new one in the background when the file changes and swaps it in (see CGHost :: Update)
+
+class CIPBlackList
+{
+private:
+	string m_File;
+	uint32_t m_NumEntries;
+	vector<uint32_t> m_Children;			// two per node, the index of the child node for a 0 bit and a 1 bit (0 means no child since the root is never a child)
+	vector<unsigned char> m_Blocked;		// one per node, every address with this node's prefix is blacklisted
+
+	void AddPrefix( uint32_t ip, uint32_t length );
+	void AddRange( uint32_t start, uint32_t end );
+	bool AddLine( string line );
+
+public:
+	CIPBlackList( );
+	~CIPBlackList( );
+
+	string GetFile( )				{ return m_File; }
+	uint32_t GetNumEntries( )		{ return m_NumEntries; }
+	uint32_t GetNumNodes( )			{ return m_Blocked.size( ); }
+
+	bool Load( string file );
+	bool Check( uint32_t ip );		// ip is in host byte order
+};
+
+//
+// CIPBlackListLoad
+//
+
+// loads a blacklist in a background thread, this works the same way as CMapLoad
+
+namespace boost { class thread; class mutex; }
+
+class CIPBlackListLoad
+{
+private:
+	string m_File;
+	CIPBlackList *m_BlackList;
+	boost::thread *m_Thread;
+	boost::mutex *m_Mutex;			// protects m_BlackList and m_Ready
+	bool m_Ready;
+
+public:
+	CIPBlackListLoad( string nFile );
+	~CIPBlackListLoad( );
+
+	string GetFile( )				{ return m_File; }
+	bool GetReady( );
+	CIPBlackList *TakeBlackList( );	// the caller owns the returned blacklist
+
+	void operator( )( );
+};
+
+#endif
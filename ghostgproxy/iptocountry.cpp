@@ -0,0 +1,322 @@
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#include "ghost.h"
+#include "util.h"
+#include "csvparser.h"
+#include "iptocountry.h"
+
+#include <string.h>
+#include <sys/stat.h>
+
+// snapshot format (native byte order, it's a local cache and isn't meant to be copied between machines)
+//  4 bytes		-> "IP2C"
+//  4 bytes		-> snapshot version
+//  4 bytes		-> size of the csv file
+//  4 bytes		-> modification time of the csv file
+//  4 bytes		-> number of countries, then for each country 1 byte length + country code
+//  4 bytes		-> number of ranges (n), then n range starts, n range ends (4 bytes each) and n country indexes (2 bytes each)
+
+#define IPTOCOUNTRY_SNAPSHOT_VERSION 2
+
+class CIPRange
+{
+public:
+	uint32_t m_Start;
+	uint32_t m_End;
+	uint16_t m_Country;
+
+	CIPRange( uint32_t nStart, uint32_t nEnd, uint16_t nCountry ) : m_Start( nStart ), m_End( nEnd ), m_Country( nCountry ) { }
+	bool operator<( const CIPRange &other ) const	{ return m_Start < other.m_Start || ( m_Start == other.m_Start && m_End < other.m_End ); }
+};
+
+//
+// CIPToCountry
+//
+
+CIPToCountry :: CIPToCountry( )
+{
+
+}
+
+CIPToCountry :: ~CIPToCountry( )
+{
+
+}
+
+bool CIPToCountry :: Load( string csvFileName, string snapshotFileName )
+{
+	struct stat CSVStat;
+
+	if( stat( csvFileName.c_str( ), &CSVStat ) != 0 )
+	{
+		// there's no csv file so use the snapshot no matter what it was built from
+
+		if( LoadSnapshot( snapshotFileName, 0, 0 ) )
+			return true;
+
+		CONSOLE_Print( "[IPTOCOUNTRY] warning - unable to read file [" + csvFileName + "], iptocountry data not loaded" );
+		return false;
+	}
+
+	uint32_t CSVSize = CSVStat.st_size;
+	uint32_t CSVTime = CSVStat.st_mtime;
+
+	if( LoadSnapshot( snapshotFileName, CSVSize, CSVTime ) )
+		return true;
+
+	if( !LoadCSV( csvFileName ) )
+		return false;
+
+	SaveSnapshot( snapshotFileName, CSVSize, CSVTime );
+	return true;
+}
+
+string CIPToCountry :: Lookup( uint32_t ip )
+{
+	if( m_Starts.empty( ) )
+		return "??";
+
+	// binary search for the last range starting at or before the ip
+	// the loop always runs log2(n) times and the comparison compiles to a conditional move so there are no branches to mispredict
+
+	const uint32_t *Base = &m_Starts[0];
+	uint32_t Size = m_Starts.size( );
+
+	while( Size > 1 )
+	{
+		uint32_t Half = Size / 2;
+		Base = Base[Half] <= ip ? Base + Half : Base;
+		Size -= Half;
+	}
+
+	uint32_t i = Base - &m_Starts[0];
+
+	if( m_Starts[i] <= ip && ip <= m_Ends[i] )
+		return m_CountryNames[m_Countries[i]];
+
+	return "??";
+}
+
+bool CIPToCountry :: LoadCSV( string fileName )
+{
+	ifstream in;
+	in.open( fileName.c_str( ) );
+
+	if( in.fail( ) )
+	{
+		CONSOLE_Print( "[IPTOCOUNTRY] warning - unable to read file [" + fileName + "], iptocountry data not loaded" );
+		return false;
+	}
+
+	CONSOLE_Print( "[IPTOCOUNTRY] started loading [" + fileName + "]" );
+
+	vector<CIPRange> Ranges;
+	map<string,uint16_t> CountryIDs;
+	string Line;
+	string IP1;
+	string IP2;
+	string Country;
+	CSVParser parser;
+
+	m_CountryNames.clear( );
+
+	while( !in.eof( ) )
+	{
+		getline( in, Line );
+
+		if( Line.empty( ) )
+			continue;
+
+		parser << Line;
+		parser >> IP1;
+		parser >> IP2;
+		parser >> Country;
+
+		uint32_t Start = UTIL_ToUInt32( IP1 );
+		uint32_t End = UTIL_ToUInt32( IP2 );
+
+		if( Start > End )
+			continue;
+
+		map<string,uint16_t> :: iterator CountryID = CountryIDs.find( Country );
+
+		if( CountryID == CountryIDs.end( ) )
+		{
+			if( m_CountryNames.size( ) >= 65535 || Country.size( ) > 255 )
+				continue;
+
+			CountryID = CountryIDs.insert( make_pair( Country, (uint16_t)m_CountryNames.size( ) ) ).first;
+			m_CountryNames.push_back( Country );
+		}
+
+		Ranges.push_back( CIPRange( Start, End, CountryID->second ) );
+	}
+
+	in.close( );
+
+	// the binary search needs the ranges sorted and not overlapping
+	// if two ranges overlap the one that starts first wins where they overlap and the rest of the later one is kept, this matches what the old "ip1<=? AND ip2>=?" query returned
+
+	sort( Ranges.begin( ), Ranges.end( ) );
+	m_Starts.clear( );
+	m_Ends.clear( );
+	m_Countries.clear( );
+	m_Starts.reserve( Ranges.size( ) );
+	m_Ends.reserve( Ranges.size( ) );
+	m_Countries.reserve( Ranges.size( ) );
+
+	for( vector<CIPRange> :: iterator i = Ranges.begin( ); i != Ranges.end( ); i++ )
+	{
+		uint32_t Start = i->m_Start;
+
+		if( !m_Ends.empty( ) && Start <= m_Ends.back( ) )
+		{
+			if( i->m_End <= m_Ends.back( ) )
+				continue;
+
+			Start = m_Ends.back( ) + 1;
+		}
+
+		m_Starts.push_back( Start );
+		m_Ends.push_back( i->m_End );
+		m_Countries.push_back( i->m_Country );
+	}
+
+	CONSOLE_Print( "[IPTOCOUNTRY] finished loading [" + fileName + "], " + UTIL_ToString( m_Starts.size( ) ) + " ranges in " + UTIL_ToString( m_CountryNames.size( ) ) + " countries" );
+	return true;
+}
+
+bool CIPToCountry :: LoadSnapshot( string fileName, uint32_t csvSize, uint32_t csvTime )
+{
+	// csvSize and csvTime are zero if there's no csv file to compare the snapshot against
+
+	if( !UTIL_FileExists( fileName ) )
+		return false;
+
+	string Data = UTIL_FileRead( fileName );
+	const char *Pos = Data.data( );
+	const char *End = Pos + Data.size( );
+	uint32_t Header[5];
+
+	if( Data.size( ) < sizeof( Header ) || memcmp( Pos, "IP2C", 4 ) != 0 )
+	{
+		CONSOLE_Print( "[IPTOCOUNTRY] snapshot [" + fileName + "] is invalid, rebuilding it" );
+		return false;
+	}
+
+	memcpy( Header, Pos, sizeof( Header ) );
+	Pos += sizeof( Header );
+
+	if( Header[1] != IPTOCOUNTRY_SNAPSHOT_VERSION || ( csvSize != 0 && ( Header[2] != csvSize || Header[3] != csvTime ) ) )
+	{
+		CONSOLE_Print( "[IPTOCOUNTRY] snapshot [" + fileName + "] is out of date, rebuilding it" );
+		return false;
+	}
+
+	vector<string> CountryNames;
+
+	for( uint32_t i = 0; i < Header[4]; i++ )
+	{
+		if( Pos >= End || End - Pos < 1 + (unsigned char)*Pos )
+		{
+			CONSOLE_Print( "[IPTOCOUNTRY] snapshot [" + fileName + "] is truncated, rebuilding it" );
+			return false;
+		}
+
+		CountryNames.push_back( string( Pos + 1, (unsigned char)*Pos ) );
+		Pos += 1 + (unsigned char)*Pos;
+	}
+
+	uint32_t Ranges;
+
+	if( End - Pos < 4 )
+	{
+		CONSOLE_Print( "[IPTOCOUNTRY] snapshot [" + fileName + "] is truncated, rebuilding it" );
+		return false;
+	}
+
+	memcpy( &Ranges, Pos, 4 );
+	Pos += 4;
+
+	if( (uint64_t)( End - Pos ) != (uint64_t)Ranges * 10 )
+	{
+		CONSOLE_Print( "[IPTOCOUNTRY] snapshot [" + fileName + "] is truncated, rebuilding it" );
+		return false;
+	}
+
+	m_Starts.resize( Ranges );
+	m_Ends.resize( Ranges );
+	m_Countries.resize( Ranges );
+	m_CountryNames = CountryNames;
+
+	if( Ranges > 0 )
+	{
+		memcpy( &m_Starts[0], Pos, Ranges * 4 );
+		memcpy( &m_Ends[0], Pos + Ranges * 4, Ranges * 4 );
+		memcpy( &m_Countries[0], Pos + Ranges * 8, Ranges * 2 );
+	}
+
+	// make sure every country index is valid so Lookup doesn't have to check
+
+	for( uint32_t i = 0; i < Ranges; i++ )
+	{
+		if( m_Countries[i] >= m_CountryNames.size( ) )
+			m_Countries[i] = 0;
+	}
+
+	if( m_CountryNames.empty( ) && Ranges > 0 )
+		m_CountryNames.push_back( "??" );
+
+	CONSOLE_Print( "[IPTOCOUNTRY] loaded " + UTIL_ToString( Ranges ) + " ranges in " + UTIL_ToString( m_CountryNames.size( ) ) + " countries from snapshot [" + fileName + "]" );
+	return true;
+}
+
+bool CIPToCountry :: SaveSnapshot( string fileName, uint32_t csvSize, uint32_t csvTime )
+{
+	string Data = "IP2C";
+	uint32_t Header[4] = { IPTOCOUNTRY_SNAPSHOT_VERSION, csvSize, csvTime, (uint32_t)m_CountryNames.size( ) };
+	uint32_t Ranges = m_Starts.size( );
+	Data.append( (char *)Header, sizeof( Header ) );
+
+	for( vector<string> :: iterator i = m_CountryNames.begin( ); i != m_CountryNames.end( ); i++ )
+	{
+		Data.push_back( (char)i->size( ) );
+		Data += *i;
+	}
+
+	Data.append( (char *)&Ranges, 4 );
+
+	if( Ranges > 0 )
+	{
+		Data.append( (char *)&m_Starts[0], Ranges * 4 );
+		Data.append( (char *)&m_Ends[0], Ranges * 4 );
+		Data.append( (char *)&m_Countries[0], Ranges * 2 );
+	}
+
+	if( !UTIL_FileWrite( fileName, (unsigned char *)Data.data( ), Data.size( ) ) )
+	{
+		CONSOLE_Print( "[IPTOCOUNTRY] warning - unable to write snapshot [" + fileName + "]" );
+		return false;
+	}
+
+	CONSOLE_Print( "[IPTOCOUNTRY] wrote snapshot [" + fileName + "]" );
+	return true;
+}
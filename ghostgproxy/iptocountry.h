@@ -0,0 +1,54 @@
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#ifndef IPTOCOUNTRY_H
+#define IPTOCOUNTRY_H
+
+//
+// CIPToCountry
+//
+
+// the iptocountry data is kept in memory as a sorted array of ip ranges so looking up a player's country is just a binary search
+// parsing ip-to-country.csv takes a while so the parsed ranges are written to a binary snapshot which is loaded instead on the next start
+// the snapshot remembers the size and modification time of the csv file it was built from and is rebuilt when the csv file changes
+
+class CIPToCountry
+{
+private:
+	vector<uint32_t> m_Starts;					// the first ip of each range, sorted
+	vector<uint32_t> m_Ends;					// the last ip of each range
+	vector<uint16_t> m_Countries;				// the country of each range as an index into m_CountryNames
+	vector<string> m_CountryNames;				// the distinct country codes (e.g. "US")
+
+	bool LoadCSV( string fileName );
+	bool LoadSnapshot( string fileName, uint32_t csvSize, uint32_t csvTime );
+	bool SaveSnapshot( string fileName, uint32_t csvSize, uint32_t csvTime );
+
+public:
+	CIPToCountry( );
+	~CIPToCountry( );
+
+	uint32_t GetNumRanges( )					{ return m_Starts.size( ); }
+
+	bool Load( string csvFileName, string snapshotFileName );
+	string Lookup( uint32_t ip );				// returns "??" if the ip isn't in any range
+};
+
+#endif
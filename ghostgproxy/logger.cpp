@@ -0,0 +1,389 @@
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+#include "ghost.h"
+#include "util.h"
+#include "config.h"
+#include "logger.h"
+
+#include <time.h>
+
+#include <boost/thread.hpp>
+
+#ifdef WIN32
+ #include <windows.h>
+#endif
+
+// the number of messages each thread can have waiting for the logging thread, must be a power of two
+
+#define LOG_RING_SIZE 4096
+
+uint32_t gLogLevels[LOGCAT_NUMCATEGORIES] = { LOGLEVEL_INFO, LOGLEVEL_INFO, LOGLEVEL_INFO, LOGLEVEL_INFO };
+CLogger *gLogger = NULL;
+
+void CONSOLE_Print( string message )
+{
+	LOG_Print( LOGCAT_GENERAL, LOGLEVEL_INFO, message );
+}
+
+void LOG_Write( uint32_t level, string message )
+{
+	string File;
+
+	if( gLogger )
+		gLogger->Push( level, File, message );
+	else
+	{
+		// the logger hasn't been started yet or has already been stopped
+
+		cout << message << endl;
+	}
+}
+
+void LOG_WriteFile( string file, string message )
+{
+	if( gLogger )
+		gLogger->Push( LOGLEVEL_DEBUG, file, message );
+}
+
+static void LogMemoryBarrier( )
+{
+#ifdef WIN32
+	MemoryBarrier( );
+#else
+	__sync_synchronize( );
+#endif
+}
+
+//
+// CLogRing
+//
+
+class CLogMessage
+{
+public:
+	time_t m_Time;
+	uint32_t m_Ticks;
+	string m_File;					// empty for the console and the log file
+	string m_Message;
+
+	CLogMessage( ) : m_Time( 0 ), m_Ticks( 0 ) { }
+};
+
+class CLogRing
+{
+public:
+	CLogMessage m_Messages[LOG_RING_SIZE];
+	volatile uint32_t m_Head;		// the next message to read, only written by the logging thread
+	volatile uint32_t m_Tail;		// the next message to write, only written by the owning thread
+	volatile uint32_t m_Dropped;	// only written by the owning thread
+	uint32_t m_DroppedReported;		// only used by the logging thread
+	volatile bool m_Pushing;		// only used by the owning thread to notice a signal handler logging in the middle of a push
+	volatile bool m_Closed;			// the owning thread exited, the logging thread deletes the ring once it's empty
+
+	CLogRing( ) : m_Head( 0 ), m_Tail( 0 ), m_Dropped( 0 ), m_DroppedReported( 0 ), m_Pushing( false ), m_Closed( false ) { }
+};
+
+static void CloseLogRing( CLogRing *ring )
+{
+	LogMemoryBarrier( );
+	ring->m_Closed = true;
+}
+
+static boost :: thread_specific_ptr<CLogRing> gLogRing( CloseLogRing );
+
+//
+// CLogger
+//
+
+CLogger :: CLogger( string nFile, uint32_t nMethod ) : m_File( nFile ), m_Method( nMethod ), m_Log( NULL ), m_Exiting( false )
+{
+	if( !m_File.empty( ) && m_Method == 2 )
+	{
+		// log method 2: open the log on startup, flush the log after every batch of messages, close the log on shutdown
+		// the log file CANNOT be edited/moved/deleted while GHost++ is running
+
+		m_Log = new ofstream( );
+		m_Log->open( m_File.c_str( ), ios :: app );
+	}
+
+	// log method 1: open, append, and close the log for every batch of messages
+	// the log file can be edited/moved/deleted while GHost++ is running
+
+	m_RingsMutex = new boost :: mutex( );
+	m_Thread = new boost :: thread( boost :: ref( *this ) );
+}
+
+CLogger :: ~CLogger( )
+{
+	// the logging thread writes everything that's left before it exits
+	// every other thread that logs must have exited by now
+
+	m_Exiting = true;
+	m_Thread->join( );
+	delete m_Thread;
+	delete m_RingsMutex;
+	gLogRing.release( );
+
+	for( vector<CLogRing *> :: iterator i = m_Rings.begin( ); i != m_Rings.end( ); i++ )
+		delete *i;
+
+	if( m_Log )
+	{
+		if( !m_Log->fail( ) )
+			m_Log->close( );
+
+		delete m_Log;
+	}
+}
+
+bool CLogger :: GetLogOpen( )
+{
+	if( m_File.empty( ) )
+		return false;
+
+	if( m_Method == 2 )
+		return m_Log && !m_Log->fail( );
+
+	return true;
+}
+
+void CLogger :: SetLevels( CConfig *CFG )
+{
+	static const char *Categories[LOGCAT_NUMCATEGORIES] = { "general", "network", "stats", "database" };
+	uint32_t Level = CFG->GetInt( "bot_loglevel", LOGLEVEL_INFO );
+
+	for( uint32_t i = 0; i < LOGCAT_NUMCATEGORIES; i++ )
+		gLogLevels[i] = CFG->GetInt( string( "bot_loglevel_" ) + Categories[i], Level );
+}
+
+void CLogger :: Push( uint32_t level, string &file, string &message )
+{
+	CLogRing *Ring = GetRing( );
+
+	if( Ring->m_Pushing )
+	{
+		// a signal handler interrupted a push on this thread, using the ring now would corrupt it
+
+		cout << message << endl;
+		return;
+	}
+
+	Ring->m_Pushing = true;
+	uint32_t Tail = Ring->m_Tail;
+
+	while( Tail - Ring->m_Head >= LOG_RING_SIZE )
+	{
+		// the ring is full because the logging thread can't keep up
+		// errors and warnings wait for it, anything less important is dropped
+		// except messages for a separate file (e.g. the packet log) since a gap in those can't be explained by the "[LOG] dropped" line in the main log
+
+		if( level > LOGLEVEL_WARNING && file.empty( ) )
+		{
+			Ring->m_Dropped++;
+			Ring->m_Pushing = false;
+			return;
+		}
+
+		MILLISLEEP( 1 );
+	}
+
+	// the barriers make sure we've seen the logging thread finish with the slot before we write to it
+	// and that the logging thread sees the message before it sees the new tail
+
+	LogMemoryBarrier( );
+	CLogMessage &Message = Ring->m_Messages[Tail % LOG_RING_SIZE];
+	Message.m_Time = time( NULL );
+	Message.m_Ticks = GetTicks( );
+	Message.m_File.swap( file );
+	Message.m_Message.swap( message );
+	LogMemoryBarrier( );
+	Ring->m_Tail = Tail + 1;
+	Ring->m_Pushing = false;
+}
+
+void CLogger :: operator( )( )
+{
+	while( !m_Exiting )
+	{
+		if( !Flush( ) )
+			MILLISLEEP( 10 );
+	}
+
+	while( Flush( ) )
+		;
+}
+
+CLogRing *CLogger :: GetRing( )
+{
+	CLogRing *Ring = gLogRing.get( );
+
+	if( !Ring )
+	{
+		// this thread is logging for the first time
+
+		Ring = new CLogRing( );
+		m_RingsMutex->lock( );
+		m_Rings.push_back( Ring );
+		m_RingsMutex->unlock( );
+		gLogRing.reset( Ring );
+	}
+
+	return Ring;
+}
+
+bool CLogger :: Flush( )
+{
+	vector<CLogMessage> Messages;
+	m_RingsMutex->lock( );
+
+	for( vector<CLogRing *> :: iterator i = m_Rings.begin( ); i != m_Rings.end( ); )
+	{
+		CLogRing *Ring = *i;
+
+		// check if the ring was closed before reading the tail so we can't miss its last messages
+
+		bool Closed = Ring->m_Closed;
+		LogMemoryBarrier( );
+		uint32_t Head = Ring->m_Head;
+		uint32_t Tail = Ring->m_Tail;
+		LogMemoryBarrier( );
+
+		for( ; Head != Tail; Head++ )
+		{
+			CLogMessage &Message = Ring->m_Messages[Head % LOG_RING_SIZE];
+			Messages.push_back( CLogMessage( ) );
+			Messages.back( ).m_Time = Message.m_Time;
+			Messages.back( ).m_Ticks = Message.m_Ticks;
+			Messages.back( ).m_File.swap( Message.m_File );
+			Messages.back( ).m_Message.swap( Message.m_Message );
+		}
+
+		LogMemoryBarrier( );
+		Ring->m_Head = Head;
+		uint32_t Dropped = Ring->m_Dropped;
+
+		if( Dropped != Ring->m_DroppedReported )
+		{
+			Messages.push_back( CLogMessage( ) );
+			Messages.back( ).m_Time = time( NULL );
+			Messages.back( ).m_Ticks = GetTicks( );
+			Messages.back( ).m_Message = "[LOG] dropped " + UTIL_ToString( Dropped - Ring->m_DroppedReported ) + " messages because the log couldn't keep up";
+			Ring->m_DroppedReported = Dropped;
+		}
+
+		if( Closed )
+		{
+			delete Ring;
+			i = m_Rings.erase( i );
+		}
+		else
+			i++;
+	}
+
+	m_RingsMutex->unlock( );
+
+	if( Messages.empty( ) )
+		return false;
+
+	Write( Messages );
+	return true;
+}
+
+static bool LogMessageEarlier( const CLogMessage &a, const CLogMessage &b )
+{
+	return (int32_t)( a.m_Ticks - b.m_Ticks ) < 0;
+}
+
+void CLogger :: Write( vector<CLogMessage> &messages )
+{
+	// the messages are in order for each thread but not between threads
+
+	stable_sort( messages.begin( ), messages.end( ), LogMessageEarlier );
+
+	string Console;
+	string Log;
+	map<string, string> Files;
+	time_t LastTime = 0;
+	string Time;
+
+	for( vector<CLogMessage> :: iterator i = messages.begin( ); i != messages.end( ); i++ )
+	{
+		if( !i->m_File.empty( ) )
+		{
+			Files[i->m_File] += i->m_Message + "\n";
+			continue;
+		}
+
+		Console += i->m_Message + "\n";
+
+		if( !m_File.empty( ) )
+		{
+			if( Time.empty( ) || i->m_Time != LastTime )
+			{
+				LastTime = i->m_Time;
+				Time = asctime( localtime( &LastTime ) );
+
+				// erase the newline
+
+				Time.erase( Time.size( ) - 1 );
+			}
+
+			Log += "[" + Time + "] " + i->m_Message + "\n";
+		}
+	}
+
+	if( !Console.empty( ) )
+		cout << Console << flush;
+
+	if( !Log.empty( ) )
+	{
+		if( m_Method == 1 )
+		{
+			ofstream File;
+			File.open( m_File.c_str( ), ios :: app );
+
+			if( !File.fail( ) )
+			{
+				File << Log;
+				File.close( );
+			}
+		}
+		else if( m_Method == 2 )
+		{
+			if( m_Log && !m_Log->fail( ) )
+			{
+				*m_Log << Log;
+				m_Log->flush( );
+			}
+		}
+	}
+
+	for( map<string, string> :: iterator i = Files.begin( ); i != Files.end( ); i++ )
+	{
+		ofstream File;
+		File.open( i->first.c_str( ), ios :: app );
+
+		if( !File.fail( ) )
+		{
+			File << i->second;
+			File.close( );
+		}
+	}
+}
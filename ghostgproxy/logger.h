@@ -0,0 +1,68 @@
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+#ifndef LOGGER_H
+#define LOGGER_H
+
+//
+// CLogger
+//
+
+// CONSOLE_Print and LOG_Print don't write anything themselves, they put the message in a ring buffer owned by the calling thread
+// the logging thread collects the messages from every ring buffer and writes them to the console and the log files in batches
+// each ring buffer has exactly one producer (its thread) and one consumer (the logging thread) so passing a message needs no locks
+// when a ring buffer is full info and debug messages are dropped and counted, errors, warnings and messages for other files (LOG_WriteFile) wait for the logging thread instead
+
+namespace boost { class thread; class mutex; }
+
+class CConfig;
+class CLogRing;
+class CLogMessage;
+
+class CLogger
+{
+private:
+	string m_File;							// the log file, empty if logging to a file is disabled
+	uint32_t m_Method;						// bot_logmethod
+	ofstream *m_Log;						// the log file when using log method 2
+	boost::thread *m_Thread;
+	boost::mutex *m_RingsMutex;				// protects m_Rings, locked by the logging thread while it collects messages and by other threads only when they log for the first time
+	vector<CLogRing *> m_Rings;
+	volatile bool m_Exiting;
+
+public:
+	CLogger( string nFile, uint32_t nMethod );
+	~CLogger( );
+
+	string GetFile( )		{ return m_File; }
+	uint32_t GetMethod( )	{ return m_Method; }
+	bool GetLogOpen( );
+
+	static void SetLevels( CConfig *CFG );
+
+	void Push( uint32_t level, string &file, string &message );
+	void operator( )( );
+
+private:
+	CLogRing *GetRing( );
+	bool Flush( );
+	void Write( vector<CLogMessage> &messages );
+};
+
+#endif
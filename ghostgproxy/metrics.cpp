@@ -0,0 +1,371 @@
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+#include "ghost.h"
+#include "util.h"
+#include "socket.h"
+#include "game_base.h"
+#include "game_admin.h"
+#include "bnetqueue.h"
+#include "bnet.h"
+#include "commandtable.h"
+#include "metrics.h"
+
+#ifdef WIN32
+ #include <windows.h>
+#endif
+
+static void AtomicAdd( volatile uint32_t *dest, uint32_t value )
+{
+#ifdef WIN32
+	InterlockedExchangeAdd( (LONG volatile *)dest, value );
+#else
+	__sync_fetch_and_add( dest, value );
+#endif
+}
+
+static void AtomicAdd( volatile uint64_t *dest, uint64_t value )
+{
+#ifdef WIN32
+	InterlockedExchangeAdd64( (LONGLONG volatile *)dest, value );
+#else
+	__sync_fetch_and_add( dest, value );
+#endif
+}
+
+//
+// CHistogram
+//
+
+CHistogram :: CHistogram( uint32_t nScale ) : m_Scale( nScale == 0 ? 1 : nScale ), m_Sum( 0 )
+{
+	for( uint32_t i = 0; i <= HISTOGRAM_BUCKETS; i++ )
+		m_Buckets[i] = 0;
+}
+
+CHistogram :: ~CHistogram( )
+{
+
+}
+
+void CHistogram :: Add( uint32_t value )
+{
+	uint32_t Bucket = 0;
+	uint32_t Limit = m_Scale;
+
+	while( Bucket < HISTOGRAM_BUCKETS && value > Limit )
+	{
+		Bucket++;
+		Limit <<= 1;
+	}
+
+	AtomicAdd( &m_Buckets[Bucket], 1 );
+	AtomicAdd( &m_Sum, value );
+}
+
+void CHistogram :: Write( string &out, const string &name, const string &labels )
+{
+	// the buckets are cumulative in the Prometheus format
+	// the count is the +Inf bucket so it always agrees with the buckets even if values are added while we're reading them
+
+	string Prefix = labels.empty( ) ? string( "{" ) : "{" + labels + ",";
+	uint32_t Count = 0;
+
+	for( uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++ )
+	{
+		Count += m_Buckets[i];
+		out += name + "_bucket" + Prefix + "le=\"" + UTIL_ToString( m_Scale << i ) + "\"} " + UTIL_ToString( Count ) + "\n";
+	}
+
+	Count += m_Buckets[HISTOGRAM_BUCKETS];
+	out += name + "_bucket" + Prefix + "le=\"+Inf\"} " + UTIL_ToString( Count ) + "\n";
+	string Labels = labels.empty( ) ? string( ) : "{" + labels + "}";
+	out += name + "_sum" + Labels + " " + UTIL_ToString( (double)m_Sum, 0 ) + "\n";
+	out += name + "_count" + Labels + " " + UTIL_ToString( Count ) + "\n";
+}
+
+//
+// CGameMetrics
+//
+
+CGameMetrics :: CGameMetrics( ) : m_UpdateTime( 16 ), m_SendActionsTime( 16 ), m_ActionJitter( 1 ), m_ActionQueueDepth( 1 ), m_SendBufferDepth( 64 ), m_Latency( 0 )
+{
+	for( uint32_t i = 0; i < 256; i++ )
+		m_PlayerSendBuffers[i] = 0xFFFFFFFF;
+}
+
+CGameMetrics :: ~CGameMetrics( )
+{
+
+}
+
+//
+// CMetricsServer
+//
+
+static string EscapeLabel( const string &value )
+{
+	string Result;
+
+	for( string :: const_iterator i = value.begin( ); i != value.end( ); i++ )
+	{
+		if( *i == '\\' )
+			Result += "\\\\";
+		else if( *i == '"' )
+			Result += "\\\"";
+		else if( *i == '\n' )
+			Result += "\\n";
+		else
+			Result += *i;
+	}
+
+	return Result;
+}
+
+static void WriteHeader( string &out, const string &name, const string &type, const string &help )
+{
+	out += "# HELP " + name + " " + help + "\n";
+	out += "# TYPE " + name + " " + type + "\n";
+}
+
+CMetricsServer :: CMetricsServer( CGHost *nGHost, string nBindAddress, uint16_t nPort ) : m_GHost( nGHost ), m_Socket( NULL ), m_BindAddress( nBindAddress ), m_Port( nPort ), m_LastListenTime( 0 )
+{
+
+}
+
+CMetricsServer :: ~CMetricsServer( )
+{
+	delete m_Socket;
+
+	for( vector<CTCPSocket *> :: iterator i = m_Connections.begin( ); i != m_Connections.end( ); i++ )
+		delete *i;
+
+	for( vector<CTCPSocket *> :: iterator i = m_Responding.begin( ); i != m_Responding.end( ); i++ )
+		delete *i;
+}
+
+unsigned int CMetricsServer :: SetFD( void *fd, void *send_fd, int *nfds )
+{
+	unsigned int NumFDs = 0;
+
+	if( m_Socket )
+	{
+		m_Socket->SetFD( (fd_set *)fd, (fd_set *)send_fd, nfds );
+		NumFDs++;
+	}
+
+	for( vector<CTCPSocket *> :: iterator i = m_Connections.begin( ); i != m_Connections.end( ); i++ )
+	{
+		(*i)->SetFD( (fd_set *)fd, (fd_set *)send_fd, nfds );
+		NumFDs++;
+	}
+
+	for( vector<CTCPSocket *> :: iterator i = m_Responding.begin( ); i != m_Responding.end( ); i++ )
+	{
+		(*i)->SetFD( (fd_set *)fd, (fd_set *)send_fd, nfds );
+		NumFDs++;
+	}
+
+	return NumFDs;
+}
+
+void CMetricsServer :: Update( void *fd, void *send_fd )
+{
+	// start listening, or try again every 60 seconds if we couldn't
+
+	if( !m_Socket && ( m_LastListenTime == 0 || GetTime( ) - m_LastListenTime >= 60 ) )
+	{
+		m_LastListenTime = GetTime( );
+		m_Socket = new CTCPServer( );
+
+		if( m_Socket->Listen( m_BindAddress, m_Port ) )
+			CONSOLE_Print( "[METRICS] listening for metrics requests on port " + UTIL_ToString( m_Port ) );
+		else
+		{
+			CONSOLE_Print( "[METRICS] error listening for metrics requests on port " + UTIL_ToString( m_Port ) );
+			delete m_Socket;
+			m_Socket = NULL;
+		}
+	}
+	else if( m_Socket && m_Socket->HasError( ) )
+	{
+		CONSOLE_Print( "[METRICS] metrics listener error (" + m_Socket->GetErrorString( ) + ")" );
+		delete m_Socket;
+		m_Socket = NULL;
+	}
+
+	if( m_Socket )
+	{
+		CTCPSocket *NewSocket = m_Socket->Accept( (fd_set *)fd );
+
+		if( NewSocket )
+			m_Connections.push_back( NewSocket );
+	}
+
+	for( vector<CTCPSocket *> :: iterator i = m_Connections.begin( ); i != m_Connections.end( ); )
+	{
+		// we respond to the first request and close the connection once the response is sent
+		// so we only have to notice when the whole request has arrived, everything in the request itself is ignored
+
+		if( (*i)->HasError( ) || !(*i)->GetConnected( ) || GetTime( ) - (*i)->GetLastRecv( ) >= 10 )
+		{
+			delete *i;
+			i = m_Connections.erase( i );
+			continue;
+		}
+
+		(*i)->DoRecv( (fd_set *)fd );
+		CRingBuffer *RecvBuffer = (*i)->GetBytes( );
+		string Request( (char *)RecvBuffer->GetData( ), RecvBuffer->GetSize( ) );
+
+		if( Request.find( "\r\n\r\n" ) != string :: npos || Request.find( "\n\n" ) != string :: npos || Request.size( ) >= 8192 )
+		{
+			string Metrics = GetMetrics( );
+			(*i)->PutBytes( "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " + UTIL_ToString( Metrics.size( ) ) + "\r\nConnection: close\r\n\r\n" + Metrics );
+			(*i)->ClearRecvBuffer( );
+			m_Responding.push_back( *i );
+			i = m_Connections.erase( i );
+		}
+		else
+			i++;
+	}
+
+	for( vector<CTCPSocket *> :: iterator i = m_Responding.begin( ); i != m_Responding.end( ); )
+	{
+		(*i)->DoSend( (fd_set *)send_fd );
+
+		if( (*i)->HasError( ) || !(*i)->GetConnected( ) || (*i)->GetSendBufferSize( ) == 0 || GetTime( ) - (*i)->GetLastSend( ) >= 10 )
+		{
+			delete *i;
+			i = m_Responding.erase( i );
+		}
+		else
+			i++;
+	}
+}
+
+string CMetricsServer :: GetMetrics( )
+{
+	string Out;
+
+	WriteHeader( Out, "ghost_update_microseconds", "histogram", "Time spent in each loop of the main thread, not counting waiting for sockets." );
+	m_GHost->m_UpdateTime->Write( Out, "ghost_update_microseconds", string( ) );
+	WriteHeader( Out, "ghost_callable_latency_milliseconds", "histogram", "Time from queueing a database callable until the main thread sees it completed." );
+	m_GHost->m_CallableLatency->Write( Out, "ghost_callable_latency_milliseconds", string( ) );
+	WriteHeader( Out, "ghost_callable_run_milliseconds", "histogram", "Time a worker thread spent running a database callable." );
+	m_GHost->m_CallableRunTime->Write( Out, "ghost_callable_run_milliseconds", string( ) );
+
+	vector<CBaseGame *> Games;
+
+	if( m_GHost->m_CurrentGame )
+		Games.push_back( m_GHost->m_CurrentGame );
+
+	if( m_GHost->m_AdminGame )
+		Games.push_back( m_GHost->m_AdminGame );
+
+	Games.insert( Games.end( ), m_GHost->m_Games.begin( ), m_GHost->m_Games.end( ) );
+	WriteHeader( Out, "ghost_games", "gauge", "Number of games including the lobby and the admin game." );
+	Out += "ghost_games " + UTIL_ToString( Games.size( ) ) + "\n";
+
+	vector<string> Labels;
+
+	for( vector<CBaseGame *> :: iterator i = Games.begin( ); i != Games.end( ); i++ )
+		Labels.push_back( "game_id=\"" + UTIL_ToString( (*i)->GetHostCounter( ) ) + "\",game=\"" + EscapeLabel( (*i)->GetGameName( ) ) + "\"" );
+
+	// every game's series for a metric have to follow that metric's header
+
+	static const char *Names[] = { "ghost_game_update_microseconds", "ghost_game_send_actions_microseconds", "ghost_game_action_jitter_milliseconds", "ghost_game_action_queue_depth", "ghost_game_send_buffer_bytes" };
+	static const char *Helps[] = { "Time spent updating the game in each loop.", "Time spent sending each action packet.", "Difference between the actual and the expected time between action packets.", "Number of actions in each action packet.", "Bytes waiting in each player's send buffer after sending an action packet." };
+	static CHistogram CGameMetrics :: *Histograms[] = { &CGameMetrics :: m_UpdateTime, &CGameMetrics :: m_SendActionsTime, &CGameMetrics :: m_ActionJitter, &CGameMetrics :: m_ActionQueueDepth, &CGameMetrics :: m_SendBufferDepth };
+
+	for( uint32_t i = 0; i < 5; i++ )
+	{
+		WriteHeader( Out, Names[i], "histogram", Helps[i] );
+
+		for( uint32_t j = 0; j < Games.size( ); j++ )
+			( Games[j]->GetMetrics( )->*Histograms[i] ).Write( Out, Names[i], Labels[j] );
+	}
+
+	WriteHeader( Out, "ghost_game_latency_milliseconds", "gauge", "Time between action packets the game is trying to keep." );
+
+	for( uint32_t i = 0; i < Games.size( ); i++ )
+		Out += "ghost_game_latency_milliseconds{" + Labels[i] + "} " + UTIL_ToString( Games[i]->GetMetrics( )->m_Latency ) + "\n";
+
+	WriteHeader( Out, "ghost_game_player_send_buffer_bytes", "gauge", "Bytes waiting in the player's send buffer after sending the last action packet." );
+
+	for( uint32_t i = 0; i < Games.size( ); i++ )
+	{
+		CGameMetrics *Metrics = Games[i]->GetMetrics( );
+
+		for( uint32_t j = 0; j < 256; j++ )
+		{
+			uint32_t SendBuffer = Metrics->m_PlayerSendBuffers[j];
+
+			if( SendBuffer != 0xFFFFFFFF )
+				Out += "ghost_game_player_send_buffer_bytes{" + Labels[i] + ",pid=\"" + UTIL_ToString( j ) + "\"} " + UTIL_ToString( SendBuffer ) + "\n";
+		}
+	}
+
+	// the battle.net outgoing packet queues, one series per server and packet class
+
+	vector<string> QueueLabels;
+
+	for( vector<CBNET *> :: iterator i = m_GHost->m_BNETs.begin( ); i != m_GHost->m_BNETs.end( ); i++ )
+	{
+		for( uint32_t j = 0; j < OUTPACKET_NUMCLASSES; j++ )
+			QueueLabels.push_back( "server=\"" + EscapeLabel( (*i)->GetServerAlias( ) ) + "\",class=\"" + CBNETOutQueue :: GetClassName( j ) + "\"" );
+	}
+
+	static const char *QueueNames[] = { "ghost_bnet_queue_depth", "ghost_bnet_packets_sent_total", "ghost_bnet_packets_merged_total", "ghost_bnet_packets_dropped_total" };
+	static const char *QueueTypes[] = { "gauge", "counter", "counter", "counter" };
+	static const char *QueueHelps[] = { "Number of packets waiting to be sent to battle.net.", "Packets sent to battle.net.", "Packets that replaced or duplicated a packet already waiting to be sent.", "Packets discarded because too many packets of their class were waiting." };
+
+	for( uint32_t i = 0; i < 4; i++ )
+	{
+		WriteHeader( Out, QueueNames[i], QueueTypes[i], QueueHelps[i] );
+
+		for( uint32_t j = 0; j < QueueLabels.size( ); j++ )
+		{
+			CBNETOutQueue *Queue = m_GHost->m_BNETs[j / OUTPACKET_NUMCLASSES]->GetOutQueue( );
+			uint32_t Class = j % OUTPACKET_NUMCLASSES;
+			uint32_t Values[] = { Queue->GetSize( Class ), Queue->m_Sent[Class], Queue->m_Merged[Class], Queue->m_Dropped[Class] };
+			Out += string( QueueNames[i] ) + "{" + QueueLabels[j] + "} " + UTIL_ToString( Values[i] ) + "\n";
+		}
+	}
+
+	WriteHeader( Out, "ghost_bnet_queue_latency_milliseconds", "histogram", "Time each packet waited before being sent to battle.net." );
+
+	for( uint32_t i = 0; i < QueueLabels.size( ); i++ )
+		m_GHost->m_BNETs[i / OUTPACKET_NUMCLASSES]->GetOutQueue( )->m_Latency[i % OUTPACKET_NUMCLASSES]->Write( Out, "ghost_bnet_queue_latency_milliseconds", QueueLabels[i] );
+
+	// the bot commands, the count of each command's histogram is the number of times it was used
+
+	WriteHeader( Out, "ghost_command_microseconds", "histogram", "Time spent handling each bot command." );
+	CCommandTable *Tables[] = { m_GHost->m_GameCommands, m_GHost->m_AdminGameCommands, m_GHost->m_BNETCommands };
+
+	for( uint32_t i = 0; i < 3; i++ )
+	{
+		vector<CCommand *> Commands = Tables[i]->GetCommands( );
+
+		for( vector<CCommand *> :: iterator j = Commands.begin( ); j != Commands.end( ); j++ )
+			(*j)->GetTime( )->Write( Out, "ghost_command_microseconds", "table=\"" + Tables[i]->GetName( ) + "\",command=\"" + (*j)->GetName( ) + "\"" );
+	}
+
+	return Out;
+}
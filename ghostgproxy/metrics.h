@@ -0,0 +1,100 @@
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+#ifndef METRICS_H
+#define METRICS_H
+
+// the number of finite buckets in a histogram, bucket i counts the values <= scale * 2^i
+
+#define HISTOGRAM_BUCKETS 16
+
+//
+// CHistogram
+//
+
+// a histogram with power of two buckets which is cheap enough to leave on all the time
+// Add only does atomic increments so it can be called from any thread and a scrape never blocks the thread being measured
+
+class CHistogram
+{
+private:
+	uint32_t m_Scale;
+	volatile uint32_t m_Buckets[HISTOGRAM_BUCKETS + 1];		// the last bucket counts the values larger than every finite bucket
+	volatile uint64_t m_Sum;
+
+public:
+	CHistogram( uint32_t nScale );
+	~CHistogram( );
+
+	void Add( uint32_t value );
+	void Write( string &out, const string &name, const string &labels );
+};
+
+//
+// CGameMetrics
+//
+
+// what a game records about itself, everything here is written by the game and only read by the metrics server
+
+class CGameMetrics
+{
+public:
+	CHistogram m_UpdateTime;						// microseconds spent in Update and UpdatePost per loop
+	CHistogram m_SendActionsTime;					// microseconds spent in SendAllActions
+	CHistogram m_ActionJitter;						// milliseconds between the actual and the expected action interval (m_Latency)
+	CHistogram m_ActionQueueDepth;					// number of actions sent in each action packet
+	CHistogram m_SendBufferDepth;					// bytes waiting in each player's send buffer after sending actions
+	volatile uint32_t m_Latency;
+	volatile uint32_t m_PlayerSendBuffers[256];		// bytes waiting in the send buffer of the player with each PID after sending actions, 0xFFFFFFFF if there's no such player
+
+	CGameMetrics( );
+	~CGameMetrics( );
+};
+
+//
+// CMetricsServer
+//
+
+// serves the metrics over HTTP in the Prometheus text format (e.g. curl http://127.0.0.1:6300/metrics)
+// this runs on the main thread as part of CGHost :: Update
+
+class CTCPServer;
+class CTCPSocket;
+
+class CMetricsServer
+{
+private:
+	CGHost *m_GHost;
+	CTCPServer *m_Socket;
+	vector<CTCPSocket *> m_Connections;			// connections we're waiting for a request on
+	vector<CTCPSocket *> m_Responding;			// connections we're sending a response on, closed once it's sent
+	string m_BindAddress;
+	uint16_t m_Port;
+	uint32_t m_LastListenTime;
+
+public:
+	CMetricsServer( CGHost *nGHost, string nBindAddress, uint16_t nPort );
+	~CMetricsServer( );
+
+	unsigned int SetFD( void *fd, void *send_fd, int *nfds );
+	void Update( void *fd, void *send_fd );
+	string GetMetrics( );
+};
+
+#endif
@@ -1,416 +1,789 @@
-/*
-
-   Copyright [2008] [Trevor Hogan]
-
-   Licensed under the Apache License, Version 2.0 (the "License");
-   you may not use this file except in compliance with the License.
-   You may obtain a copy of the License at
-
-       http://www.apache.org/licenses/LICENSE-2.0
-
-   Unless required by applicable law or agreed to in writing, software
-   distributed under the License is distributed on an "AS IS" BASIS,
-   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-   See the License for the specific language governing permissions and
-   limitations under the License.
-
-   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
-
-*/
-
-#include "ghost.h"
-#include "util.h"
-#include "crc32.h"
-#include "packed.h"
-
-#include <zlib.h>
-
-// we can't use zlib's uncompress function because it expects a complete compressed buffer
-// however, we're going to be passing it chunks of incomplete data
-// this custom tzuncompress function will do the job
-
-int tzuncompress( Bytef *dest, uLongf *destLen, const Bytef *source, uLong sourceLen )
-{
-	z_stream stream;
-	int err;
-
-	stream.next_in = (Bytef*)source;
-	stream.avail_in = (uInt)sourceLen;
-	/* Check for source > 64K on 16-bit machine: */
-	if ((uLong)stream.avail_in != sourceLen) return Z_BUF_ERROR;
-
-	stream.next_out = dest;
-	stream.avail_out = (uInt)*destLen;
-	if ((uLong)stream.avail_out != *destLen) return Z_BUF_ERROR;
-
-	stream.zalloc = (alloc_func)0;
-	stream.zfree = (free_func)0;
-
-	err = inflateInit(&stream);
-	if (err != Z_OK) return err;
-
-	err = inflate(&stream, Z_SYNC_FLUSH);
-	if (err != Z_STREAM_END && err != Z_OK) {
-		inflateEnd(&stream);
-		if (err == Z_NEED_DICT || (err == Z_BUF_ERROR && stream.avail_in == 0))
-			return Z_DATA_ERROR;
-		return err;
-	}
-	*destLen = stream.total_out;
-
-	err = inflateEnd(&stream);
-	return err;
-}
-
-//
-// CPacked
-//
-
-CPacked :: CPacked( )
-{
-	m_CRC = new CCRC32( );
-	m_CRC->Initialize( );
-	m_Valid = true;
-	m_HeaderSize = 0;
-	m_CompressedSize = 0;
-	m_HeaderVersion = 0;
-	m_DecompressedSize = 0;
-	m_NumBlocks = 0;
-	m_War3Identifier = 0;
-	m_War3Version = 0;
-	m_BuildNumber = 0;
-	m_Flags = 0;
-	m_ReplayLength = 0;
-}
-
-CPacked :: ~CPacked( )
-{
-	delete m_CRC;
-}
-
-void CPacked :: Load( string fileName, bool allBlocks )
-{
-	m_Valid = true;
-	CONSOLE_Print( "[PACKED] loading data from file [" + fileName + "]" );
-	m_Compressed = UTIL_FileRead( fileName );
-	Decompress( allBlocks );
-}
-
-bool CPacked :: Save( )
-{
-	if ( !m_SavePath.empty() )
-		return Save( m_TFT, m_SavePath );
-	else
-		CONSOLE_Print( "[REPLAY] Saving failed, no path is set!" );
-		
-	return false;
-}
-
-bool CPacked :: Save( bool TFT, string fileName )
-{
-	Compress( TFT );
-
-	if( m_Valid )
-	{
-		CONSOLE_Print( "[PACKED] saving data to file [" + fileName + "]" );
-		return UTIL_FileWrite( fileName, (unsigned char *)m_Compressed.c_str( ), m_Compressed.size( ) );
-	}
-	else
-		return false;
-}
-
-bool CPacked :: Extract( string inFileName, string outFileName )
-{
-	m_Valid = true;
-	CONSOLE_Print( "[PACKED] extracting data from file [" + inFileName + "] to file [" + outFileName + "]" );
-	m_Compressed = UTIL_FileRead( inFileName );
-	Decompress( true );
-
-	if( m_Valid )
-		return UTIL_FileWrite( outFileName, (unsigned char *)m_Decompressed.c_str( ), m_Decompressed.size( ) );
-	else
-		return false;
-}
-
-bool CPacked :: Pack( bool TFT, string inFileName, string outFileName )
-{
-	m_Valid = true;
-	CONSOLE_Print( "[PACKET] packing data from file [" + inFileName + "] to file [" + outFileName + "]" );
-	m_Decompressed = UTIL_FileRead( inFileName );
-	Compress( TFT );
-
-	if( m_Valid )
-		return UTIL_FileWrite( outFileName, (unsigned char *)m_Compressed.c_str( ), m_Compressed.size( ) );
-	else
-		return false;
-}
-
-void CPacked :: Decompress( bool allBlocks )
-{
-	CONSOLE_Print( "[PACKED] decompressing data" );
-
-	// format found at http://www.thehelper.net/forums/showthread.php?t=42787
-
-	m_Decompressed.clear( );
-	istringstream ISS( m_Compressed );
-	string GarbageString;
-
-	// read header
-
-	getline( ISS, GarbageString, '\0' );
-
-	if( GarbageString != "Warcraft III recorded game\x01A" )
-	{
-		CONSOLE_Print( "[PACKED] not a valid packed file" );
-		m_Valid = false;
-		return;
-	}
-
-	ISS.read( (char *)&m_HeaderSize, 4 );			// header size
-	ISS.read( (char *)&m_CompressedSize, 4 );		// compressed file size
-	ISS.read( (char *)&m_HeaderVersion, 4 );		// header version
-	ISS.read( (char *)&m_DecompressedSize, 4 );		// decompressed file size
-	ISS.read( (char *)&m_NumBlocks, 4 );			// number of blocks
-
-	if( m_HeaderVersion == 0 )
-	{
-		ISS.seekg( 2, ios :: cur );					// unknown
-		ISS.seekg( 2, ios :: cur );					// version number
-
-		CONSOLE_Print( "[PACKED] header version is too old" );
-		m_Valid = false;
-		return;
-	}
-	else
-	{
-		ISS.read( (char *)&m_War3Identifier, 4 );	// version identifier
-		ISS.read( (char *)&m_War3Version, 4 );		// version number
-	}
-
-	ISS.read( (char *)&m_BuildNumber, 2 );			// build number
-	ISS.read( (char *)&m_Flags, 2 );				// flags
-	ISS.read( (char *)&m_ReplayLength, 4 );			// replay length
-	ISS.seekg( 4, ios :: cur );						// CRC
-
-	if( ISS.fail( ) )
-	{
-		CONSOLE_Print( "[PACKED] failed to read header" );
-		m_Valid = false;
-		return;
-	}
-
-	if( allBlocks )
-		CONSOLE_Print( "[PACKED] reading " + UTIL_ToString( m_NumBlocks ) + " blocks" );
-	else
-		CONSOLE_Print( "[PACKED] reading 1/" + UTIL_ToString( m_NumBlocks ) + " blocks" );
-
-	// read blocks
-
-	for( uint32_t i = 0; i < m_NumBlocks; i++ )
-	{
-		uint16_t BlockCompressed;
-		uint16_t BlockDecompressed;
-
-		// read block header
-
-		ISS.read( (char *)&BlockCompressed, 2 );	// block compressed size
-		ISS.read( (char *)&BlockDecompressed, 2 );	// block decompressed size
-		ISS.seekg( 4, ios :: cur );					// checksum
-
-		if( ISS.fail( ) )
-		{
-			CONSOLE_Print( "[PACKED] failed to read block header" );
-			m_Valid = false;
-			return;
-		}
-
-		// read block data
-
-		uLongf BlockCompressedLong = BlockCompressed;
-		uLongf BlockDecompressedLong = BlockDecompressed;
-		unsigned char *CompressedData = new unsigned char[BlockCompressed];
-		unsigned char *DecompressedData = new unsigned char[BlockDecompressed];
-		ISS.read( (char*)CompressedData, BlockCompressed );
-
-		if( ISS.fail( ) )
-		{
-			CONSOLE_Print( "[PACKED] failed to read block data" );
-			delete [] DecompressedData;
-			delete [] CompressedData;
-			m_Valid = false;
-			return;
-		}
-
-		// decompress block data
-
-		int Result = tzuncompress( DecompressedData, &BlockDecompressedLong, CompressedData, BlockCompressedLong );
-
-		if( Result != Z_OK )
-		{
-			CONSOLE_Print( "[PACKED] tzuncompress error " + UTIL_ToString( Result ) );
-			delete [] DecompressedData;
-			delete [] CompressedData;
-			m_Valid = false;
-			return;
-		}
-
-		if( BlockDecompressedLong != (uLongf)BlockDecompressed )
-		{
-			CONSOLE_Print( "[PACKED] block decompressed size mismatch, actual = " + UTIL_ToString( BlockDecompressedLong ) + ", expected = " + UTIL_ToString( BlockDecompressed ) );
-			delete [] DecompressedData;
-			delete [] CompressedData;
-			m_Valid = false;
-			return;
-		}
-
-		m_Decompressed += string( (char *)DecompressedData, BlockDecompressedLong );
-		delete [] DecompressedData;
-		delete [] CompressedData;
-
-		// stop after one iteration if not decompressing all blocks
-
-		if( !allBlocks )
-			break;
-	}
-
-	CONSOLE_Print( "[PACKED] decompressed " + UTIL_ToString( m_Decompressed.size( ) ) + " bytes" );
-
-	if( allBlocks || m_NumBlocks == 1 )
-	{
-		if( m_DecompressedSize > m_Decompressed.size( ) )
-		{
-			CONSOLE_Print( "[PACKED] not enough decompressed data" );
-			m_Valid = false;
-			return;
-		}
-
-		// the last block is padded with zeros, discard them
-
-		CONSOLE_Print( "[PACKED] discarding " + UTIL_ToString( m_Decompressed.size( ) - m_DecompressedSize ) + " bytes" );
-		m_Decompressed.erase( m_DecompressedSize );
-	}
-}
-
-void CPacked :: Compress( bool TFT )
-{
-	CONSOLE_Print( "[PACKED] compressing data" );
-
-	// format found at http://www.thehelper.net/forums/showthread.php?t=42787
-
-	m_Compressed.clear( );
-
-	// compress data into blocks of size 8192 bytes
-	// use a buffer of size 8213 bytes because in the worst case zlib will grow the data 0.1% plus 12 bytes
-
-	uint32_t CompressedSize = 0;
-	string Padded = m_Decompressed;
-	Padded.append( 8192 - ( Padded.size( ) % 8192 ), 0 );
-	vector<string> CompressedBlocks;
-	string :: size_type Position = 0;
-	unsigned char *CompressedData = new unsigned char[8213];
-
-	while( Position < Padded.size( ) )
-	{
-		uLongf BlockCompressedLong = 8213;
-		int Result = compress( CompressedData, &BlockCompressedLong, (const Bytef *)Padded.c_str( ) + Position, 8192 );
-
-		if( Result != Z_OK )
-		{
-			CONSOLE_Print( "[PACKED] compress error " + UTIL_ToString( Result ) );
-			delete [] CompressedData;
-			m_Valid = false;
-			return;
-		}
-
-		CompressedBlocks.push_back( string( (char *)CompressedData, BlockCompressedLong ) );
-		CompressedSize += BlockCompressedLong;
-		Position += 8192;
-	}
-
-	delete [] CompressedData;
-
-	// build header
-
-	uint32_t HeaderSize = 68;
-	uint32_t HeaderCompressedSize = HeaderSize + CompressedSize + CompressedBlocks.size( ) * 8;
-	uint32_t HeaderVersion = 1;
-	BYTEARRAY Header;
-	UTIL_AppendByteArray( Header, "Warcraft III recorded game\x01A" );
-	UTIL_AppendByteArray( Header, HeaderSize, false );
-	UTIL_AppendByteArray( Header, HeaderCompressedSize, false );
-	UTIL_AppendByteArray( Header, HeaderVersion, false );
-	UTIL_AppendByteArray( Header, (uint32_t)m_Decompressed.size( ), false );
-	UTIL_AppendByteArray( Header, (uint32_t)CompressedBlocks.size( ), false );
-
-	if( TFT )
-	{
-		Header.push_back( 'P' );	// "W3XP"
-		Header.push_back( 'X' );
-		Header.push_back( '3' );
-		Header.push_back( 'W' );
-	}
-	else
-	{
-		Header.push_back( '3' );	// "WAR3"
-		Header.push_back( 'R' );
-		Header.push_back( 'A' );
-		Header.push_back( 'W' );
-	}
-
-	UTIL_AppendByteArray( Header, m_War3Version, false );
-	UTIL_AppendByteArray( Header, m_BuildNumber, false );
-	UTIL_AppendByteArray( Header, m_Flags, false );
-	UTIL_AppendByteArray( Header, m_ReplayLength, false );
-
-	// append zero header CRC
-	// the header CRC is calculated over the entire header with itself set to zero
-	// we'll overwrite the zero header CRC after we calculate it
-
-	UTIL_AppendByteArray( Header, (uint32_t)0, false );
-
-	// calculate header CRC
-
-	string HeaderString = string( Header.begin( ), Header.end( ) );
-	uint32_t CRC = m_CRC->FullCRC( (unsigned char *)HeaderString.c_str( ), HeaderString.size( ) );
-
-	// overwrite the (currently zero) header CRC with the calculated CRC
-
-	Header.erase( Header.end( ) - 4, Header.end( ) );
-	UTIL_AppendByteArray( Header, CRC, false );
-
-	// append header
-
-	m_Compressed += string( Header.begin( ), Header.end( ) );
-
-	// append blocks
-
-	for( vector<string> :: iterator i = CompressedBlocks.begin( ); i != CompressedBlocks.end( ); i++ )
-	{
-		BYTEARRAY BlockHeader;
-		UTIL_AppendByteArray( BlockHeader, (uint16_t)(*i).size( ), false );
-		UTIL_AppendByteArray( BlockHeader, (uint16_t)8192, false );
-
-		// append zero block header CRC
-
-		UTIL_AppendByteArray( BlockHeader, (uint32_t)0, false );
-
-		// calculate block header CRC
-
-		string BlockHeaderString = string( BlockHeader.begin( ), BlockHeader.end( ) );
-		uint32_t CRC1 = m_CRC->FullCRC( (unsigned char *)BlockHeaderString.c_str( ), BlockHeaderString.size( ) );
-		CRC1 = CRC1 ^ ( CRC1 >> 16 );
-		uint32_t CRC2 = m_CRC->FullCRC( (unsigned char *)(*i).c_str( ), (*i).size( ) );
-		CRC2 = CRC2 ^ ( CRC2 >> 16 );
-		uint32_t BlockCRC = ( CRC1 & 0xFFFF ) | ( CRC2 << 16 );
-
-		// overwrite the block header CRC with the calculated CRC
-
-		BlockHeader.erase( BlockHeader.end( ) - 4, BlockHeader.end( ) );
-		UTIL_AppendByteArray( BlockHeader, BlockCRC, false );
-
-		// append block header and data
-
-		m_Compressed += string( BlockHeader.begin( ), BlockHeader.end( ) );
-		m_Compressed += *i;
-	}
-}
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#include "ghost.h"
+#include "util.h"
+#include "crc32.h"
+#include "packed.h"
+
+#include <sys/stat.h>
+
+#ifndef WIN32
+ #include <fcntl.h>
+ #include <sys/mman.h>
+#endif
+
+#include <zlib.h>
+
+// we can't use zlib's uncompress function because it expects a complete compressed buffer
+// however, we're going to be passing it chunks of incomplete data
+// this custom tzuncompress function will do the job
+
+int tzuncompress( Bytef *dest, uLongf *destLen, const Bytef *source, uLong sourceLen )
+{
+	z_stream stream;
+	int err;
+
+	stream.next_in = (Bytef*)source;
+	stream.avail_in = (uInt)sourceLen;
+	/* Check for source > 64K on 16-bit machine: */
+	if ((uLong)stream.avail_in != sourceLen) return Z_BUF_ERROR;
+
+	stream.next_out = dest;
+	stream.avail_out = (uInt)*destLen;
+	if ((uLong)stream.avail_out != *destLen) return Z_BUF_ERROR;
+
+	stream.zalloc = (alloc_func)0;
+	stream.zfree = (free_func)0;
+
+	err = inflateInit(&stream);
+	if (err != Z_OK) return err;
+
+	err = inflate(&stream, Z_SYNC_FLUSH);
+	if (err != Z_STREAM_END && err != Z_OK) {
+		inflateEnd(&stream);
+		if (err == Z_NEED_DICT || (err == Z_BUF_ERROR && stream.avail_in == 0))
+			return Z_DATA_ERROR;
+		return err;
+	}
+	*destLen = stream.total_out;
+
+	err = inflateEnd(&stream);
+	return err;
+}
+
+//
+// CPacked
+//
+
+CPacked :: CPacked( )
+{
+	m_CRC = new CCRC32( );
+	m_CRC->Initialize( );
+	m_Valid = true;
+	m_HeaderSize = 0;
+	m_CompressedSize = 0;
+	m_HeaderVersion = 0;
+	m_DecompressedSize = 0;
+	m_NumBlocks = 0;
+	m_War3Identifier = 0;
+	m_War3Version = 0;
+	m_BuildNumber = 0;
+	m_Flags = 0;
+	m_ReplayLength = 0;
+	m_Reader = NULL;
+}
+
+CPacked :: ~CPacked( )
+{
+	delete m_Reader;
+	delete m_CRC;
+}
+
+void CPacked :: Load( string fileName, bool allBlocks )
+{
+	m_Valid = true;
+	CONSOLE_Print( "[PACKED] loading data from file [" + fileName + "]" );
+	m_Compressed.clear( );
+	m_Decompressed.clear( );
+	delete m_Reader;
+	m_Reader = new CPackedReader( fileName );
+
+	if( !m_Reader->GetValid( ) )
+	{
+		m_Valid = false;
+		return;
+	}
+
+	m_HeaderSize = m_Reader->GetHeaderSize( );
+	m_CompressedSize = m_Reader->GetCompressedSize( );
+	m_HeaderVersion = m_Reader->GetHeaderVersion( );
+	m_DecompressedSize = m_Reader->GetDecompressedSize( );
+	m_NumBlocks = m_Reader->GetNumBlocks( );
+	m_War3Identifier = m_Reader->GetWar3Identifier( );
+	m_War3Version = m_Reader->GetWar3Version( );
+	m_BuildNumber = m_Reader->GetBuildNumber( );
+	m_Flags = m_Reader->GetFlags( );
+	m_ReplayLength = m_Reader->GetReplayLength( );
+
+	// the blocks are decompressed as they're parsed (see CPackedBuffer) so there's nothing else to do unless the caller wants all the data up front
+
+	if( allBlocks )
+	{
+		CPackedBuffer Buffer( m_Reader );
+		m_Decompressed.reserve( m_DecompressedSize );
+		m_Decompressed.assign( istreambuf_iterator<char>( &Buffer ), istreambuf_iterator<char>( ) );
+
+		if( m_Decompressed.size( ) < m_DecompressedSize )
+		{
+			CONSOLE_Print( "[PACKED] not enough decompressed data" );
+			m_Valid = false;
+		}
+	}
+}
+
+bool CPacked :: Save( )
+{
+	if ( !m_SavePath.empty() )
+		return Save( m_TFT, m_SavePath );
+	else
+		CONSOLE_Print( "[REPLAY] Saving failed, no path is set!" );
+		
+	return false;
+}
+
+bool CPacked :: Save( bool TFT, string fileName )
+{
+	Compress( TFT );
+
+	if( m_Valid )
+	{
+		CONSOLE_Print( "[PACKED] saving data to file [" + fileName + "]" );
+		return UTIL_FileWrite( fileName, (unsigned char *)m_Compressed.c_str( ), m_Compressed.size( ) );
+	}
+	else
+		return false;
+}
+
+bool CPacked :: Extract( string inFileName, string outFileName )
+{
+	m_Valid = true;
+	CONSOLE_Print( "[PACKED] extracting data from file [" + inFileName + "] to file [" + outFileName + "]" );
+	m_Compressed = UTIL_FileRead( inFileName );
+	Decompress( true );
+
+	if( m_Valid )
+		return UTIL_FileWrite( outFileName, (unsigned char *)m_Decompressed.c_str( ), m_Decompressed.size( ) );
+	else
+		return false;
+}
+
+bool CPacked :: Pack( bool TFT, string inFileName, string outFileName )
+{
+	m_Valid = true;
+	CONSOLE_Print( "[PACKET] packing data from file [" + inFileName + "] to file [" + outFileName + "]" );
+	m_Decompressed = UTIL_FileRead( inFileName );
+	Compress( TFT );
+
+	if( m_Valid )
+		return UTIL_FileWrite( outFileName, (unsigned char *)m_Compressed.c_str( ), m_Compressed.size( ) );
+	else
+		return false;
+}
+
+void CPacked :: Decompress( bool allBlocks )
+{
+	CONSOLE_Print( "[PACKED] decompressing data" );
+
+	// format found at http://www.thehelper.net/forums/showthread.php?t=42787
+
+	m_Decompressed.clear( );
+	istringstream ISS( m_Compressed );
+	string GarbageString;
+
+	// read header
+
+	getline( ISS, GarbageString, '\0' );
+
+	if( GarbageString != "Warcraft III recorded game\x01A" )
+	{
+		CONSOLE_Print( "[PACKED] not a valid packed file" );
+		m_Valid = false;
+		return;
+	}
+
+	ISS.read( (char *)&m_HeaderSize, 4 );			// header size
+	ISS.read( (char *)&m_CompressedSize, 4 );		// compressed file size
+	ISS.read( (char *)&m_HeaderVersion, 4 );		// header version
+	ISS.read( (char *)&m_DecompressedSize, 4 );		// decompressed file size
+	ISS.read( (char *)&m_NumBlocks, 4 );			// number of blocks
+
+	if( m_HeaderVersion == 0 )
+	{
+		ISS.seekg( 2, ios :: cur );					// unknown
+		ISS.seekg( 2, ios :: cur );					// version number
+
+		CONSOLE_Print( "[PACKED] header version is too old" );
+		m_Valid = false;
+		return;
+	}
+	else
+	{
+		ISS.read( (char *)&m_War3Identifier, 4 );	// version identifier
+		ISS.read( (char *)&m_War3Version, 4 );		// version number
+	}
+
+	ISS.read( (char *)&m_BuildNumber, 2 );			// build number
+	ISS.read( (char *)&m_Flags, 2 );				// flags
+	ISS.read( (char *)&m_ReplayLength, 4 );			// replay length
+	ISS.seekg( 4, ios :: cur );						// CRC
+
+	if( ISS.fail( ) )
+	{
+		CONSOLE_Print( "[PACKED] failed to read header" );
+		m_Valid = false;
+		return;
+	}
+
+	if( allBlocks )
+		CONSOLE_Print( "[PACKED] reading " + UTIL_ToString( m_NumBlocks ) + " blocks" );
+	else
+		CONSOLE_Print( "[PACKED] reading 1/" + UTIL_ToString( m_NumBlocks ) + " blocks" );
+
+	// read blocks
+
+	for( uint32_t i = 0; i < m_NumBlocks; i++ )
+	{
+		if( !ReadBlock( ISS, m_Decompressed ) )
+		{
+			m_Valid = false;
+			return;
+		}
+
+		// stop after one iteration if not decompressing all blocks
+
+		if( !allBlocks )
+			break;
+	}
+
+	CONSOLE_Print( "[PACKED] decompressed " + UTIL_ToString( m_Decompressed.size( ) ) + " bytes" );
+
+	if( allBlocks || m_NumBlocks == 1 )
+	{
+		if( m_DecompressedSize > m_Decompressed.size( ) )
+		{
+			CONSOLE_Print( "[PACKED] not enough decompressed data" );
+			m_Valid = false;
+			return;
+		}
+
+		// the last block is padded with zeros, discard them
+
+		CONSOLE_Print( "[PACKED] discarding " + UTIL_ToString( m_Decompressed.size( ) - m_DecompressedSize ) + " bytes" );
+		m_Decompressed.erase( m_DecompressedSize );
+	}
+}
+
+void CPacked :: Compress( bool TFT )
+{
+	CONSOLE_Print( "[PACKED] compressing data" );
+
+	// format found at http://www.thehelper.net/forums/showthread.php?t=42787
+
+	m_Compressed.clear( );
+
+	// compress data into blocks of size 8192 bytes
+
+	string Padded = m_Decompressed;
+	Padded.append( 8192 - ( Padded.size( ) % 8192 ), 0 );
+	string Blocks;
+	uint32_t NumBlocks = 0;
+
+	for( string :: size_type Position = 0; Position < Padded.size( ); Position += 8192 )
+	{
+		if( !CompressBlock( (const unsigned char *)Padded.c_str( ) + Position, Blocks ) )
+		{
+			m_Valid = false;
+			return;
+		}
+
+		NumBlocks++;
+	}
+
+	// the compressed size in the header includes the header itself
+
+	m_Compressed = BuildHeader( TFT, 68 + Blocks.size( ), m_Decompressed.size( ), NumBlocks );
+	m_Compressed += Blocks;
+}
+
+string CPacked :: BuildHeader( bool TFT, uint32_t compressedSize, uint32_t decompressedSize, uint32_t numBlocks )
+{
+	uint32_t HeaderSize = 68;
+	uint32_t HeaderVersion = 1;
+	BYTEARRAY Header;
+	UTIL_AppendByteArray( Header, "Warcraft III recorded game\x01A" );
+	UTIL_AppendByteArray( Header, HeaderSize, false );
+	UTIL_AppendByteArray( Header, compressedSize, false );
+	UTIL_AppendByteArray( Header, HeaderVersion, false );
+	UTIL_AppendByteArray( Header, decompressedSize, false );
+	UTIL_AppendByteArray( Header, numBlocks, false );
+
+	if( TFT )
+	{
+		Header.push_back( 'P' );	// "W3XP"
+		Header.push_back( 'X' );
+		Header.push_back( '3' );
+		Header.push_back( 'W' );
+	}
+	else
+	{
+		Header.push_back( '3' );	// "WAR3"
+		Header.push_back( 'R' );
+		Header.push_back( 'A' );
+		Header.push_back( 'W' );
+	}
+
+	UTIL_AppendByteArray( Header, m_War3Version, false );
+	UTIL_AppendByteArray( Header, m_BuildNumber, false );
+	UTIL_AppendByteArray( Header, m_Flags, false );
+	UTIL_AppendByteArray( Header, m_ReplayLength, false );
+
+	// append zero header CRC
+	// the header CRC is calculated over the entire header with itself set to zero
+	// we'll overwrite the zero header CRC after we calculate it
+
+	UTIL_AppendByteArray( Header, (uint32_t)0, false );
+
+	// calculate header CRC
+
+	string HeaderString = string( Header.begin( ), Header.end( ) );
+	uint32_t CRC = m_CRC->FullCRC( (unsigned char *)HeaderString.c_str( ), HeaderString.size( ) );
+
+	// overwrite the (currently zero) header CRC with the calculated CRC
+
+	Header.erase( Header.end( ) - 4, Header.end( ) );
+	UTIL_AppendByteArray( Header, CRC, false );
+	return string( Header.begin( ), Header.end( ) );
+}
+
+bool CPacked :: CompressBlock( const unsigned char *data, string &blocks )
+{
+	// compress 8192 bytes of data and append the block header and compressed data to blocks
+	// use a buffer of size 8213 bytes because in the worst case zlib will grow the data 0.1% plus 12 bytes
+
+	unsigned char CompressedData[8213];
+	uLongf BlockCompressedLong = 8213;
+	int Result = compress( CompressedData, &BlockCompressedLong, data, 8192 );
+
+	if( Result != Z_OK )
+	{
+		CONSOLE_Print( "[PACKED] compress error " + UTIL_ToString( Result ) );
+		return false;
+	}
+
+	BYTEARRAY BlockHeader;
+	UTIL_AppendByteArray( BlockHeader, (uint16_t)BlockCompressedLong, false );
+	UTIL_AppendByteArray( BlockHeader, (uint16_t)8192, false );
+
+	// append zero block header CRC
+
+	UTIL_AppendByteArray( BlockHeader, (uint32_t)0, false );
+
+	// calculate block header CRC
+
+	string BlockHeaderString = string( BlockHeader.begin( ), BlockHeader.end( ) );
+	uint32_t CRC1 = m_CRC->FullCRC( (unsigned char *)BlockHeaderString.c_str( ), BlockHeaderString.size( ) );
+	CRC1 = CRC1 ^ ( CRC1 >> 16 );
+	uint32_t CRC2 = m_CRC->FullCRC( CompressedData, BlockCompressedLong );
+	CRC2 = CRC2 ^ ( CRC2 >> 16 );
+	uint32_t BlockCRC = ( CRC1 & 0xFFFF ) | ( CRC2 << 16 );
+
+	// overwrite the block header CRC with the calculated CRC
+
+	BlockHeader.erase( BlockHeader.end( ) - 4, BlockHeader.end( ) );
+	UTIL_AppendByteArray( BlockHeader, BlockCRC, false );
+
+	// append block header and data
+
+	blocks += string( BlockHeader.begin( ), BlockHeader.end( ) );
+	blocks += string( (char *)CompressedData, BlockCompressedLong );
+	return true;
+}
+
+bool CPacked :: ReadBlock( istream &stream, string &data )
+{
+	// read one block from the stream and append the decompressed data to data
+
+	uint16_t BlockCompressed;
+	uint16_t BlockDecompressed;
+
+	// read block header
+
+	stream.read( (char *)&BlockCompressed, 2 );		// block compressed size
+	stream.read( (char *)&BlockDecompressed, 2 );	// block decompressed size
+	stream.seekg( 4, ios :: cur );					// checksum
+
+	if( stream.fail( ) )
+	{
+		CONSOLE_Print( "[PACKED] failed to read block header" );
+		return false;
+	}
+
+	// read block data
+
+	uLongf BlockCompressedLong = BlockCompressed;
+	uLongf BlockDecompressedLong = BlockDecompressed;
+	unsigned char *CompressedData = new unsigned char[BlockCompressed];
+	unsigned char *DecompressedData = new unsigned char[BlockDecompressed];
+	stream.read( (char*)CompressedData, BlockCompressed );
+
+	if( stream.fail( ) )
+	{
+		CONSOLE_Print( "[PACKED] failed to read block data" );
+		delete [] DecompressedData;
+		delete [] CompressedData;
+		return false;
+	}
+
+	// decompress block data
+
+	int Result = tzuncompress( DecompressedData, &BlockDecompressedLong, CompressedData, BlockCompressedLong );
+
+	if( Result != Z_OK )
+	{
+		CONSOLE_Print( "[PACKED] tzuncompress error " + UTIL_ToString( Result ) );
+		delete [] DecompressedData;
+		delete [] CompressedData;
+		return false;
+	}
+
+	if( BlockDecompressedLong != (uLongf)BlockDecompressed )
+	{
+		CONSOLE_Print( "[PACKED] block decompressed size mismatch, actual = " + UTIL_ToString( BlockDecompressedLong ) + ", expected = " + UTIL_ToString( BlockDecompressed ) );
+		delete [] DecompressedData;
+		delete [] CompressedData;
+		return false;
+	}
+
+	data += string( (char *)DecompressedData, BlockDecompressedLong );
+	delete [] DecompressedData;
+	delete [] CompressedData;
+	return true;
+}
+
+//
+// CPackedReader
+//
+
+CPackedReader :: CPackedReader( string nFile )
+{
+	m_File = nFile;
+	m_Mapping = NULL;
+	m_Size = 0;
+#ifdef WIN32
+	m_FileHandle = INVALID_HANDLE_VALUE;
+	m_MappingHandle = NULL;
+#endif
+	m_Valid = false;
+	m_HeaderSize = 0;
+	m_CompressedSize = 0;
+	m_HeaderVersion = 0;
+	m_DecompressedSize = 0;
+	m_War3Identifier = 0;
+	m_War3Version = 0;
+	m_BuildNumber = 0;
+	m_Flags = 0;
+	m_ReplayLength = 0;
+
+	// map the file read only so the operating system only pages in the blocks we actually decompress
+
+#ifdef WIN32
+	m_FileHandle = CreateFileA( m_File.c_str( ), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+
+	if( m_FileHandle != INVALID_HANDLE_VALUE )
+	{
+		DWORD FileSize = GetFileSize( m_FileHandle, NULL );
+
+		if( FileSize > 0 && FileSize != INVALID_FILE_SIZE )
+		{
+			m_MappingHandle = CreateFileMapping( m_FileHandle, NULL, PAGE_READONLY, 0, 0, NULL );
+
+			if( m_MappingHandle )
+			{
+				m_Mapping = (unsigned char *)MapViewOfFile( m_MappingHandle, FILE_MAP_READ, 0, 0, 0 );
+
+				if( m_Mapping )
+					m_Size = FileSize;
+			}
+		}
+	}
+#else
+	int FD = open( m_File.c_str( ), O_RDONLY );
+
+	if( FD != -1 )
+	{
+		struct stat FileStat;
+
+		if( fstat( FD, &FileStat ) == 0 && FileStat.st_size > 0 )
+		{
+			void *Mapping = mmap( NULL, FileStat.st_size, PROT_READ, MAP_SHARED, FD, 0 );
+
+			if( Mapping != MAP_FAILED )
+			{
+				m_Mapping = (unsigned char *)Mapping;
+				m_Size = FileStat.st_size;
+			}
+		}
+
+		// the mapping stays valid after the file descriptor is closed
+
+		close( FD );
+	}
+#endif
+
+	if( !m_Mapping )
+	{
+		m_Data = UTIL_FileRead( m_File );
+		m_Size = m_Data.size( );
+	}
+
+	// read header
+	// format found at http://www.thehelper.net/forums/showthread.php?t=42787
+
+	const unsigned char *Data = GetData( );
+	const char *Signature = "Warcraft III recorded game\x01A";
+	uint32_t SignatureSize = strlen( Signature ) + 1;
+
+	if( m_Size < SignatureSize + 40 || memcmp( Data, Signature, SignatureSize ) != 0 )
+	{
+		CONSOLE_Print( "[PACKED] not a valid packed file" );
+		return;
+	}
+
+	uint32_t NumBlocks;
+	memcpy( &m_HeaderSize, Data + 28, 4 );			// header size
+	memcpy( &m_CompressedSize, Data + 32, 4 );		// compressed file size
+	memcpy( &m_HeaderVersion, Data + 36, 4 );		// header version
+	memcpy( &m_DecompressedSize, Data + 40, 4 );	// decompressed file size
+	memcpy( &NumBlocks, Data + 44, 4 );				// number of blocks
+
+	if( m_HeaderVersion == 0 )
+	{
+		CONSOLE_Print( "[PACKED] header version is too old" );
+		return;
+	}
+
+	if( m_Size < 68 || m_HeaderSize < 68 )
+	{
+		CONSOLE_Print( "[PACKED] failed to read header" );
+		return;
+	}
+
+	memcpy( &m_War3Identifier, Data + 48, 4 );		// version identifier
+	memcpy( &m_War3Version, Data + 52, 4 );			// version number
+	memcpy( &m_BuildNumber, Data + 56, 2 );			// build number
+	memcpy( &m_Flags, Data + 58, 2 );				// flags
+	memcpy( &m_ReplayLength, Data + 60, 4 );		// replay length
+
+	// index the blocks by reading each block header, nothing is decompressed yet
+
+	m_BlockOffsets.reserve( NumBlocks );
+	m_BlockStarts.reserve( NumBlocks + 1 );
+	m_BlockStarts.push_back( 0 );
+	uint32_t Offset = m_HeaderSize;
+
+	for( uint32_t i = 0; i < NumBlocks; i++ )
+	{
+		uint16_t BlockCompressed;
+		uint16_t BlockDecompressed;
+
+		if( m_Size < 8 || Offset > m_Size - 8 )
+		{
+			CONSOLE_Print( "[PACKED] failed to read block header" );
+			return;
+		}
+
+		memcpy( &BlockCompressed, Data + Offset, 2 );		// block compressed size
+		memcpy( &BlockDecompressed, Data + Offset + 2, 2 );	// block decompressed size
+
+		if( BlockCompressed > m_Size - Offset - 8 )
+		{
+			CONSOLE_Print( "[PACKED] failed to read block data" );
+			return;
+		}
+
+		m_BlockOffsets.push_back( Offset );
+		m_BlockStarts.push_back( m_BlockStarts.back( ) + BlockDecompressed );
+		Offset += 8 + BlockCompressed;
+	}
+
+	m_Valid = true;
+}
+
+CPackedReader :: ~CPackedReader( )
+{
+#ifdef WIN32
+	if( m_Mapping )
+		UnmapViewOfFile( m_Mapping );
+
+	if( m_MappingHandle )
+		CloseHandle( m_MappingHandle );
+
+	if( m_FileHandle != INVALID_HANDLE_VALUE )
+		CloseHandle( m_FileHandle );
+#else
+	if( m_Mapping )
+		munmap( m_Mapping, m_Size );
+#endif
+}
+
+uint32_t CPackedReader :: FindBlock( uint32_t position )
+{
+	// returns the block containing the given position in the decompressed data (or the number of blocks if it's past the end)
+
+	return upper_bound( m_BlockStarts.begin( ), m_BlockStarts.end( ), position ) - m_BlockStarts.begin( ) - 1;
+}
+
+bool CPackedReader :: ReadBlock( uint32_t block, string &data )
+{
+	// decompress one block and replace data with the decompressed data
+
+	if( block >= m_BlockOffsets.size( ) )
+		return false;
+
+	const unsigned char *Data = GetData( ) + m_BlockOffsets[block];
+	uint16_t BlockCompressed;
+	memcpy( &BlockCompressed, Data, 2 );
+	uLongf BlockDecompressedLong = m_BlockStarts[block + 1] - m_BlockStarts[block];
+	data.resize( BlockDecompressedLong );
+
+	if( BlockDecompressedLong == 0 )
+		return true;
+
+	int Result = tzuncompress( (Bytef *)&data[0], &BlockDecompressedLong, Data + 8, BlockCompressed );
+
+	if( Result != Z_OK )
+	{
+		CONSOLE_Print( "[PACKED] tzuncompress error " + UTIL_ToString( Result ) );
+		return false;
+	}
+
+	if( BlockDecompressedLong != data.size( ) )
+	{
+		CONSOLE_Print( "[PACKED] block decompressed size mismatch, actual = " + UTIL_ToString( BlockDecompressedLong ) + ", expected = " + UTIL_ToString( data.size( ) ) );
+		return false;
+	}
+
+	return true;
+}
+
+//
+// CPackedBuffer
+//
+
+CPackedBuffer :: CPackedBuffer( CPackedReader *nReader )
+{
+	m_Reader = nReader;
+	m_Size = 0;
+	m_Block = 0;
+	m_NextBlock = 0;
+	m_Start = 0;
+
+	if( m_Reader )
+	{
+		// the last block is padded with zeros, stop at the end of the real data
+
+		m_Size = m_Reader->GetBlockStart( m_Reader->GetNumBlocks( ) );
+		m_Block = m_Reader->GetNumBlocks( );
+
+		if( m_Reader->GetDecompressedSize( ) < m_Size )
+			m_Size = m_Reader->GetDecompressedSize( );
+	}
+
+	setg( NULL, NULL, NULL );
+}
+
+CPackedBuffer :: ~CPackedBuffer( )
+{
+
+}
+
+bool CPackedBuffer :: LoadBlock( uint32_t block )
+{
+	if( !m_Reader || block >= m_Reader->GetNumBlocks( ) || m_Reader->GetBlockStart( block ) >= m_Size )
+		return false;
+
+	if( block != m_Block )
+	{
+		if( !m_Reader->ReadBlock( block, m_Data ) )
+		{
+			m_Block = m_Reader->GetNumBlocks( );
+			m_Data.clear( );
+			return false;
+		}
+
+		m_Block = block;
+	}
+
+	m_NextBlock = block + 1;
+	m_Start = m_Reader->GetBlockStart( block );
+	uint32_t Length = m_Data.size( );
+
+	if( m_Start + Length > m_Size )
+		Length = m_Size - m_Start;
+
+	char *Data = &m_Data[0];
+	setg( Data, Data, Data + Length );
+	return true;
+}
+
+CPackedBuffer :: int_type CPackedBuffer :: underflow( )
+{
+	if( gptr( ) < egptr( ) )
+		return traits_type :: to_int_type( *gptr( ) );
+
+	// move on to the next block, skipping any empty blocks
+
+	while( LoadBlock( m_NextBlock ) )
+	{
+		if( gptr( ) < egptr( ) )
+			return traits_type :: to_int_type( *gptr( ) );
+	}
+
+	return traits_type :: eof( );
+}
+
+CPackedBuffer :: pos_type CPackedBuffer :: seekoff( off_type off, ios_base :: seekdir dir, ios_base :: openmode which )
+{
+	off_type Position = off;
+
+	if( dir == ios_base :: cur )
+		Position += m_Start + ( gptr( ) - eback( ) );
+	else if( dir == ios_base :: end )
+		Position += m_Size;
+
+	return seekpos( pos_type( Position ), which );
+}
+
+CPackedBuffer :: pos_type CPackedBuffer :: seekpos( pos_type pos, ios_base :: openmode which )
+{
+	off_type Position = pos;
+
+	if( !m_Reader || !( which & ios_base :: in ) || Position < 0 || Position > m_Size )
+		return pos_type( off_type( -1 ) );
+
+	if( Position == m_Size )
+	{
+		// there's nothing left to read
+
+		setg( NULL, NULL, NULL );
+		m_NextBlock = m_Reader->GetNumBlocks( );
+		m_Start = m_Size;
+		return pos;
+	}
+
+	uint32_t Block = m_Reader->FindBlock( Position );
+
+	if( !LoadBlock( Block ) )
+		return pos_type( off_type( -1 ) );
+
+	setg( eback( ), eback( ) + ( Position - m_Start ), egptr( ) );
+	return pos;
+}
@@ -1,84 +1,178 @@
-/*
-
-   Copyright [2008] [Trevor Hogan]
-
-   Licensed under the Apache License, Version 2.0 (the "License");
-   you may not use this file except in compliance with the License.
-   You may obtain a copy of the License at
-
-       http://www.apache.org/licenses/LICENSE-2.0
-
-   Unless required by applicable law or agreed to in writing, software
-   distributed under the License is distributed on an "AS IS" BASIS,
-   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-   See the License for the specific language governing permissions and
-   limitations under the License.
-
-   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
-
-*/
-
-#ifndef PACKED_H
-#define PACKED_H
-
-//
-// CPacked
-//
-
-class CCRC32;
-
-class CPacked
-{
-public:
-	CCRC32 *m_CRC;
-
-protected:
-	bool m_Valid;
-	string m_Compressed;
-	string m_Decompressed;
-	uint32_t m_HeaderSize;
-	uint32_t m_CompressedSize;
-	uint32_t m_HeaderVersion;
-	uint32_t m_DecompressedSize;
-	uint32_t m_NumBlocks;
-	uint32_t m_War3Identifier;
-	uint32_t m_War3Version;
-	uint16_t m_BuildNumber;
-	uint16_t m_Flags;
-	uint32_t m_ReplayLength;
-	bool	m_TFT;
-	string 	m_SavePath;
-
-public:
-	CPacked( );
-	virtual ~CPacked( );
-
-	virtual bool GetValid( )				{ return m_Valid; }
-	virtual uint32_t GetHeaderSize( )		{ return m_HeaderSize; }
-	virtual uint32_t GetCompressedSize( )	{ return m_CompressedSize; }
-	virtual uint32_t GetHeaderVersion( )	{ return m_HeaderVersion; }
-	virtual uint32_t GetDecompressedSize( )	{ return m_DecompressedSize; }
-	virtual uint32_t GetNumBlocks( )		{ return m_NumBlocks; }
-	virtual uint32_t GetWar3Identifier( )	{ return m_War3Identifier; }
-	virtual uint32_t GetWar3Version( )		{ return m_War3Version; }
-	virtual uint16_t GetBuildNumber( )		{ return m_BuildNumber; }
-	virtual uint16_t GetFlags( )			{ return m_Flags; }
-	virtual uint32_t GetReplayLength( )		{ return m_ReplayLength; }
-
-	virtual void SetWar3Version( uint32_t nWar3Version )			{ m_War3Version = nWar3Version; }
-	virtual void SetBuildNumber( uint16_t nBuildNumber )			{ m_BuildNumber = nBuildNumber; }
-	virtual void SetFlags( uint16_t nFlags )						{ m_Flags = nFlags; }
-	virtual void SetReplayLength( uint32_t nReplayLength )			{ m_ReplayLength = nReplayLength; }
-	virtual void SetTFT( bool nTFT )								{ m_TFT = nTFT; }
-	virtual void SetSavePath( string nPath )								{ m_SavePath = nPath; }
-
-	virtual void Load( string fileName, bool allBlocks );
-	virtual bool Save( );
-	virtual bool Save( bool TFT, string fileName );
-	virtual bool Extract( string inFileName, string outFileName );
-	virtual bool Pack( bool TFT, string inFileName, string outFileName );
-	virtual void Decompress( bool allBlocks );
-	virtual void Compress( bool TFT );
-};
-
-#endif
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#ifndef PACKED_H
+#define PACKED_H
+
+//
+// CPacked
+//
+
+class CCRC32;
+class CPackedReader;
+
+class CPacked
+{
+public:
+	CCRC32 *m_CRC;
+
+protected:
+	bool m_Valid;
+	string m_Compressed;
+	string m_Decompressed;
+	uint32_t m_HeaderSize;
+	uint32_t m_CompressedSize;
+	uint32_t m_HeaderVersion;
+	uint32_t m_DecompressedSize;
+	uint32_t m_NumBlocks;
+	uint32_t m_War3Identifier;
+	uint32_t m_War3Version;
+	uint16_t m_BuildNumber;
+	uint16_t m_Flags;
+	uint32_t m_ReplayLength;
+	bool	m_TFT;
+	string 	m_SavePath;
+	CPackedReader *m_Reader;		// the file the data was loaded from, the blocks are decompressed as they're parsed (see CPackedBuffer)
+
+public:
+	CPacked( );
+	virtual ~CPacked( );
+
+	virtual bool GetValid( )				{ return m_Valid; }
+	virtual uint32_t GetHeaderSize( )		{ return m_HeaderSize; }
+	virtual uint32_t GetCompressedSize( )	{ return m_CompressedSize; }
+	virtual uint32_t GetHeaderVersion( )	{ return m_HeaderVersion; }
+	virtual uint32_t GetDecompressedSize( )	{ return m_DecompressedSize; }
+	virtual uint32_t GetNumBlocks( )		{ return m_NumBlocks; }
+	virtual uint32_t GetWar3Identifier( )	{ return m_War3Identifier; }
+	virtual uint32_t GetWar3Version( )		{ return m_War3Version; }
+	virtual uint16_t GetBuildNumber( )		{ return m_BuildNumber; }
+	virtual uint16_t GetFlags( )			{ return m_Flags; }
+	virtual uint32_t GetReplayLength( )		{ return m_ReplayLength; }
+
+	virtual void SetWar3Version( uint32_t nWar3Version )			{ m_War3Version = nWar3Version; }
+	virtual void SetBuildNumber( uint16_t nBuildNumber )			{ m_BuildNumber = nBuildNumber; }
+	virtual void SetFlags( uint16_t nFlags )						{ m_Flags = nFlags; }
+	virtual void SetReplayLength( uint32_t nReplayLength )			{ m_ReplayLength = nReplayLength; }
+	virtual void SetTFT( bool nTFT )								{ m_TFT = nTFT; }
+	virtual void SetSavePath( string nPath )								{ m_SavePath = nPath; }
+
+	virtual void Load( string fileName, bool allBlocks );
+	virtual bool Save( );
+	virtual bool Save( bool TFT, string fileName );
+	virtual bool Extract( string inFileName, string outFileName );
+	virtual bool Pack( bool TFT, string inFileName, string outFileName );
+	virtual void Decompress( bool allBlocks );
+	virtual void Compress( bool TFT );
+
+protected:
+	string BuildHeader( bool TFT, uint32_t compressedSize, uint32_t decompressedSize, uint32_t numBlocks );
+	bool CompressBlock( const unsigned char *data, string &blocks );
+	bool ReadBlock( istream &stream, string &data );
+};
+
+//
+// CPackedReader
+//
+
+// reads a packed file (replay or savegame) a block at a time instead of decompressing the whole file up front
+// the file is memory mapped (or read into memory if that fails) and only the header and block headers are read when it's opened
+
+class CPackedReader
+{
+private:
+	string m_File;
+	string m_Data;						// the file data if it was read into memory
+	unsigned char *m_Mapping;			// the file data if it was memory mapped
+	uint32_t m_Size;
+#ifdef WIN32
+	void *m_FileHandle;
+	void *m_MappingHandle;
+#endif
+	bool m_Valid;
+	uint32_t m_HeaderSize;
+	uint32_t m_CompressedSize;
+	uint32_t m_HeaderVersion;
+	uint32_t m_DecompressedSize;
+	uint32_t m_War3Identifier;
+	uint32_t m_War3Version;
+	uint16_t m_BuildNumber;
+	uint16_t m_Flags;
+	uint32_t m_ReplayLength;
+	vector<uint32_t> m_BlockOffsets;	// the position of each block header in the file
+	vector<uint32_t> m_BlockStarts;		// the position of each block in the decompressed data, plus the total decompressed size of every block
+
+public:
+	CPackedReader( string nFile );
+	~CPackedReader( );
+
+	string GetFile( )					{ return m_File; }
+	bool GetValid( )					{ return m_Valid; }
+	uint32_t GetHeaderSize( )			{ return m_HeaderSize; }
+	uint32_t GetCompressedSize( )		{ return m_CompressedSize; }
+	uint32_t GetHeaderVersion( )		{ return m_HeaderVersion; }
+	uint32_t GetDecompressedSize( )		{ return m_DecompressedSize; }
+	uint32_t GetWar3Identifier( )		{ return m_War3Identifier; }
+	uint32_t GetWar3Version( )			{ return m_War3Version; }
+	uint16_t GetBuildNumber( )			{ return m_BuildNumber; }
+	uint16_t GetFlags( )				{ return m_Flags; }
+	uint32_t GetReplayLength( )			{ return m_ReplayLength; }
+	uint32_t GetNumBlocks( )			{ return m_BlockOffsets.size( ); }
+	uint32_t GetBlockStart( uint32_t block )	{ return m_BlockStarts[block]; }
+
+	uint32_t FindBlock( uint32_t position );
+	bool ReadBlock( uint32_t block, string &data );
+
+private:
+	const unsigned char *GetData( )		{ return m_Mapping ? m_Mapping : (const unsigned char *)m_Data.data( ); }
+};
+
+//
+// CPackedBuffer
+//
+
+// a stream buffer over the decompressed data of a packed file which decompresses one block at a time as it's read
+// wrap it in an istream to parse a packed file in constant memory, seeking decompresses only the block containing the new position
+// the zeros padding the last block are not part of the stream
+
+class CPackedBuffer : public streambuf
+{
+private:
+	CPackedReader *m_Reader;
+	uint32_t m_Size;
+	uint32_t m_Block;					// the block in m_Data
+	uint32_t m_NextBlock;				// the block to decompress when we run out of data
+	uint32_t m_Start;					// the position of the start of the get area in the decompressed data
+	string m_Data;
+
+public:
+	CPackedBuffer( CPackedReader *nReader );
+	virtual ~CPackedBuffer( );
+
+protected:
+	virtual int_type underflow( );
+	virtual pos_type seekoff( off_type off, ios_base :: seekdir dir, ios_base :: openmode which = ios_base :: in );
+	virtual pos_type seekpos( pos_type pos, ios_base :: openmode which = ios_base :: in );
+
+private:
+	bool LoadBlock( uint32_t block );
+};
+
+#endif
@@ -1,139 +1,169 @@
-#include <dlfcn.h>
-#include "ghost.h"
-#include "util.h"
-#include "game_base.h"
-#include "pluginmgr.h"
-#include <boost/filesystem.hpp>
-#include <boost/regex.hpp>
-
-using namespace boost :: filesystem; 
-typedef void* (*arbitrary)();
-
-CPlugin :: CPlugin(string nName, void *nHandle)
-{
-	CONSOLE_Print("[PLUGIN] Loaded plugin [" + nName + "]" );
-	m_Name = nName;
-	m_Handle = nHandle;
-}
-
-CPlugin :: ~CPlugin()
-{
-	dlclose(m_Handle);
-	CONSOLE_Print("[PLUGIN] Unloading [" + m_Name + "]" );
-}
-
-void CPlugin :: Execute(string function)
-{
-	if (!m_Handle)
-	{
-		CONSOLE_Print("[PLUGIN: " + m_Name + "] Execute aborted, called [" + function + "] but we have no handle!" );
-		return;
-	}
-
-	char *error;	
-	typedef void (*function_t)();
-	function_t PluginFunction = (function_t) dlsym(m_Handle, function.c_str());
-
-	if ((error = dlerror()) != NULL)
-	{
-		CONSOLE_Print("[PLUGIN: " + m_Name + "] Can not finding symbol for [" + function + "]" );
-		dlclose(m_Handle);
-		return;
-	}
-
-	(*PluginFunction)();
-}
-
-CPluginMgr :: CPluginMgr()
-{
-	ReloadPlugins( );
-}
-
-CPluginMgr :: ~CPluginMgr()
-{
-	UnloadPlugins( );
-}
-
-void CPluginMgr :: ReloadPlugins( )
-{
-	if (!m_LoadedPlugins.empty())
-		UnloadPlugins();
-		
-	CONSOLE_Print("[PLUGINMGR] Searching for plugins...");
-		
-	FindPlugins(path("./plugins"), true);
-	
-	CONSOLE_Print("[PLUGINMGR] Loaded " + UTIL_ToString( m_LoadedPlugins.size() ) + " plugins." );
-}
-
-void CPluginMgr :: FindPlugins( const path & directory, bool recurse_into_subdirs )
-{
-	if( exists( directory ) )
-	{
-		directory_iterator end;
-		for( directory_iterator iter(directory) ; iter != end ; ++iter )
-		{
-			if ( is_directory( *iter ) )
-			{
-				if ( recurse_into_subdirs )
-					FindPlugins(*iter);
-			}
-			else
-			{
-				CONSOLE_Print(iter->leaf());
-				boost::regex expression("^.*(so)$");
-				if (boost::regex_match(iter->leaf(),expression))
-					LoadPlugin( iter->string() );
-			}
-		}
-	}
-}
-
-void CPluginMgr :: LoadPlugin( string filename )
-{
-	char *error;
-	void* handle = dlopen(filename.c_str(), RTLD_LAZY);
-
-	CONSOLE_Print("[PLUGINMGR] Trying to load: " + filename);
-
-	if (!handle)
-	{
-		CONSOLE_Print( "[PLUGINMGR] Error loading plugin: " + filename );
-		return;
-	}
-
-	typedef string (*getname_t)();
-	getname_t GetName = (getname_t) dlsym(handle, "GetName");
-
-	if ((error = dlerror()) != NULL)
-	{
-		CONSOLE_Print("[PLUGINMGR] Error finding symbol [GetName]" );
-		dlclose(handle);
-		return;
-	}
-
-	string PluginName = (*GetName)();
-
-	m_LoadedPlugins.push_back(new CPlugin(PluginName, handle));
-}
-
-void CPluginMgr :: UnloadPlugins( )
-{
-	CONSOLE_Print("[PLUGINMGR] Unloading " + UTIL_ToString( m_LoadedPlugins.size() ) + " plugins." );
-
-	for( vector<CPlugin *> :: iterator i = m_LoadedPlugins.begin( ); i != m_LoadedPlugins.end( ); )
-	{
-		delete *i;
-		i = m_LoadedPlugins.erase( i );
-	}
-}
-
-void CPluginMgr :: Execute(string function)
-{
-	for( vector<CPlugin *> :: iterator i = m_LoadedPlugins.begin( ); i != m_LoadedPlugins.end( ); )
-	{
-		(*i)->Execute(function);
-	}
-}
-
-//vector<CPlugin *> m_LoadedPlugins;
+#include <dlfcn.h>
+#include "ghost.h"
+#include "util.h"
+#include "game_base.h"
+#include "gameprotocol.h"
+#include "pluginmgr.h"
+#include <boost/filesystem.hpp>
+#include <boost/regex.hpp>
+
+using namespace boost :: filesystem; 
+typedef void* (*arbitrary)();
+
+CPlugin :: CPlugin( string nName, void *nHandle, CPluginHooks *nHooks )
+{
+	CONSOLE_Print("[PLUGIN] Loaded plugin [" + nName + "]" );
+	m_Name = nName;
+	m_Handle = nHandle;
+	m_Hooks = nHooks;
+}
+
+CPlugin :: ~CPlugin()
+{
+	dlclose(m_Handle);
+	CONSOLE_Print("[PLUGIN] Unloading [" + m_Name + "]" );
+}
+
+CPluginMgr :: CPluginMgr()
+{
+	ReloadPlugins( );
+}
+
+CPluginMgr :: ~CPluginMgr()
+{
+	UnloadPlugins( );
+}
+
+void CPluginMgr :: ReloadPlugins( )
+{
+	if (!m_LoadedPlugins.empty())
+		UnloadPlugins();
+		
+	CONSOLE_Print("[PLUGINMGR] Searching for plugins...");
+		
+	FindPlugins(path("./plugins"), true);
+	
+	CONSOLE_Print("[PLUGINMGR] Loaded " + UTIL_ToString( m_LoadedPlugins.size() ) + " plugins." );
+}
+
+void CPluginMgr :: FindPlugins( const path & directory, bool recurse_into_subdirs )
+{
+	if( exists( directory ) )
+	{
+		directory_iterator end;
+		for( directory_iterator iter(directory) ; iter != end ; ++iter )
+		{
+			if ( is_directory( *iter ) )
+			{
+				if ( recurse_into_subdirs )
+					FindPlugins(*iter);
+			}
+			else
+			{
+				CONSOLE_Print(iter->leaf());
+				boost::regex expression("^.*(so)$");
+				if (boost::regex_match(iter->leaf(),expression))
+					LoadPlugin( iter->string() );
+			}
+		}
+	}
+}
+
+void CPluginMgr :: LoadPlugin( string filename )
+{
+	char *error;
+	void* handle = dlopen(filename.c_str(), RTLD_LAZY);
+
+	CONSOLE_Print("[PLUGINMGR] Trying to load: " + filename);
+
+	if (!handle)
+	{
+		CONSOLE_Print( "[PLUGINMGR] Error loading plugin: " + filename );
+		return;
+	}
+
+	typedef string (*getname_t)();
+	getname_t GetName = (getname_t) dlsym(handle, "GetName");
+
+	if ((error = dlerror()) != NULL)
+	{
+		CONSOLE_Print("[PLUGINMGR] Error finding symbol [GetName]" );
+		dlclose(handle);
+		return;
+	}
+
+	string PluginName = (*GetName)();
+
+	// resolve the hook table once here so calling a hook doesn't have to look anything up
+
+	typedef CPluginHooks *(*gethooks_t)();
+	gethooks_t GetHooks = (gethooks_t) dlsym(handle, "GetHooks");
+
+	if ((error = dlerror()) != NULL)
+	{
+		CONSOLE_Print("[PLUGINMGR] Error finding symbol [GetHooks] in plugin [" + PluginName + "]" );
+		dlclose(handle);
+		return;
+	}
+
+	CPluginHooks *Hooks = (*GetHooks)();
+
+	if( !Hooks || Hooks->m_Version != PLUGIN_API_VERSION )
+	{
+		CONSOLE_Print("[PLUGINMGR] Plugin [" + PluginName + "] was built for plugin API version " + UTIL_ToString( Hooks ? Hooks->m_Version : 0 ) + " but this bot uses version " + UTIL_ToString( PLUGIN_API_VERSION ) );
+		dlclose(handle);
+		return;
+	}
+
+	if( Hooks->PlayerJoined )
+		m_PlayerJoined.push_back( Hooks->PlayerJoined );
+
+	if( Hooks->ChatToHost )
+		m_ChatToHost.push_back( Hooks->ChatToHost );
+
+	if( Hooks->ActionBatch )
+		m_ActionBatch.push_back( Hooks->ActionBatch );
+
+	if( Hooks->GameEnded )
+		m_GameEnded.push_back( Hooks->GameEnded );
+
+	m_LoadedPlugins.push_back(new CPlugin(PluginName, handle, Hooks));
+}
+
+void CPluginMgr :: UnloadPlugins( )
+{
+	CONSOLE_Print("[PLUGINMGR] Unloading " + UTIL_ToString( m_LoadedPlugins.size() ) + " plugins." );
+
+	// clear the hooks first, they point into the plugins we're about to unload
+
+	m_PlayerJoined.clear( );
+	m_ChatToHost.clear( );
+	m_ActionBatch.clear( );
+	m_GameEnded.clear( );
+
+	for( vector<CPlugin *> :: iterator i = m_LoadedPlugins.begin( ); i != m_LoadedPlugins.end( ); )
+	{
+		delete *i;
+		i = m_LoadedPlugins.erase( i );
+	}
+}
+
+void CPluginMgr :: DispatchActionBatch( const string &gameName, uint32_t gameTicks, const queue<CIncomingAction *> &actions )
+{
+	// a queue can't be iterated so copy the action pointers into an array for the plugins
+
+	queue<CIncomingAction *> Actions = actions;
+	vector<const CIncomingAction *> Batch;
+	Batch.reserve( Actions.size( ) );
+
+	while( !Actions.empty( ) )
+	{
+		Batch.push_back( Actions.front( ) );
+		Actions.pop( );
+	}
+
+	for( vector<PluginActionBatch> :: iterator i = m_ActionBatch.begin( ); i != m_ActionBatch.end( ); i++ )
+		(*i)( gameName, gameTicks, &Batch[0], Batch.size( ) );
+}
+
+//vector<CPlugin *> m_LoadedPlugins;
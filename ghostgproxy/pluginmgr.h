@@ -1,44 +1,120 @@
-#ifndef PLUGINMGR_H
-#define PLUGINMGR_H
-
-#include <boost/filesystem.hpp>
-#include <boost/regex.hpp>
-
-
-class CGHost;
-class CGame;
-class CBaseGame;
-
-using namespace boost::filesystem;
-class CPlugin
-{
-private:
-	void 	*m_Handle;
-	string	m_Name;
-	
-public:
-	CPlugin(string nName, void *nHandle);
-	~CPlugin();
-	
-	void Execute(string function);
-	string GetName() { return m_Name; }
-};
-
-class CPluginMgr
-{
-public:
-	CPluginMgr();
-	~CPluginMgr();
-	
-	void ReloadPlugins( );
-	void FindPlugins( const path & directory, bool recurse_into_subdirs = false );
-	void LoadPlugin( string filename );
-	void UnloadPlugins( );
-	
-	void Execute(string function);
-
-private:
-	vector<CPlugin *> m_LoadedPlugins;
-};
-
-#endif
+#ifndef PLUGINMGR_H
+#define PLUGINMGR_H
+
+#include <boost/filesystem.hpp>
+
+
+class CGHost;
+class CGame;
+class CBaseGame;
+class CIncomingAction;
+class CIncomingChatPlayer;
+
+//
+// CPluginHooks
+//
+
+// a plugin exports "GetName" and "GetHooks", GetHooks returns a pointer to a CPluginHooks that stays valid while the plugin is loaded
+// the table is resolved once when the plugin is loaded, set m_Version to PLUGIN_API_VERSION and leave the hooks you don't need NULL
+// plugins built against a different PLUGIN_API_VERSION aren't loaded because the table layout may have changed
+// the hooks are called from the main loop and the objects passed to them are only valid during the call
+// with bot_gamethreads enabled the hooks for games in progress are called from each game's thread but always with CGHost :: m_Mutex held so no two hooks run at the same time
+
+#define PLUGIN_API_VERSION 1
+
+// a player joined a game lobby
+
+typedef void (*PluginPlayerJoined)( const string &gameName, unsigned char pid, const string &name, const string &ip );
+
+// a player sent a chat message or a team/colour/race/handicap change request (see CIncomingChatPlayer :: GetType)
+
+typedef void (*PluginChatToHost)( const string &gameName, const CIncomingChatPlayer &chatPlayer );
+
+// a batch of actions is about to be sent to every player, this is called once per action interval that has at least one action
+
+typedef void (*PluginActionBatch)( const string &gameName, uint32_t gameTicks, const CIncomingAction * const *actions, uint32_t numActions );
+
+// a game that was loaded is being deleted
+
+typedef void (*PluginGameEnded)( const string &gameName, uint32_t gameTicks );
+
+struct CPluginHooks
+{
+	uint32_t m_Version;
+	PluginPlayerJoined PlayerJoined;
+	PluginChatToHost ChatToHost;
+	PluginActionBatch ActionBatch;
+	PluginGameEnded GameEnded;
+};
+
+//
+// CPlugin
+//
+
+class CPlugin
+{
+private:
+	void 	*m_Handle;
+	string	m_Name;
+	CPluginHooks *m_Hooks;
+
+public:
+	CPlugin( string nName, void *nHandle, CPluginHooks *nHooks );
+	~CPlugin( );
+
+	string GetName( )			{ return m_Name; }
+	CPluginHooks *GetHooks( )	{ return m_Hooks; }
+};
+
+//
+// CPluginMgr
+//
+
+// the hooks of every loaded plugin are copied into one vector per event so dispatching an event nobody subscribed to only checks for an empty vector
+
+class CPluginMgr
+{
+public:
+	CPluginMgr();
+	~CPluginMgr();
+	
+	void ReloadPlugins( );
+	void FindPlugins( const boost::filesystem::path & directory, bool recurse_into_subdirs = false );
+	void LoadPlugin( string filename );
+	void UnloadPlugins( );
+
+	void PlayerJoined( const string &gameName, unsigned char pid, const string &name, const string &ip )
+	{
+		for( vector<PluginPlayerJoined> :: iterator i = m_PlayerJoined.begin( ); i != m_PlayerJoined.end( ); i++ )
+			(*i)( gameName, pid, name, ip );
+	}
+
+	void ChatToHost( const string &gameName, const CIncomingChatPlayer &chatPlayer )
+	{
+		for( vector<PluginChatToHost> :: iterator i = m_ChatToHost.begin( ); i != m_ChatToHost.end( ); i++ )
+			(*i)( gameName, chatPlayer );
+	}
+
+	void ActionBatch( const string &gameName, uint32_t gameTicks, const queue<CIncomingAction *> &actions )
+	{
+		if( !m_ActionBatch.empty( ) && !actions.empty( ) )
+			DispatchActionBatch( gameName, gameTicks, actions );
+	}
+
+	void GameEnded( const string &gameName, uint32_t gameTicks )
+	{
+		for( vector<PluginGameEnded> :: iterator i = m_GameEnded.begin( ); i != m_GameEnded.end( ); i++ )
+			(*i)( gameName, gameTicks );
+	}
+
+private:
+	vector<CPlugin *> m_LoadedPlugins;
+	vector<PluginPlayerJoined> m_PlayerJoined;
+	vector<PluginChatToHost> m_ChatToHost;
+	vector<PluginActionBatch> m_ActionBatch;
+	vector<PluginGameEnded> m_GameEnded;
+
+	void DispatchActionBatch( const string &gameName, uint32_t gameTicks, const queue<CIncomingAction *> &actions );
+};
+
+#endif
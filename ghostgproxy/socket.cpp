@@ -1,788 +1,1308 @@
-/*
-
-   Copyright [2008] [Trevor Hogan]
-
-   Licensed under the Apache License, Version 2.0 (the "License");
-   you may not use this file except in compliance with the License.
-   You may obtain a copy of the License at
-
-       http://www.apache.org/licenses/LICENSE-2.0
-
-   Unless required by applicable law or agreed to in writing, software
-   distributed under the License is distributed on an "AS IS" BASIS,
-   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-   See the License for the specific language governing permissions and
-   limitations under the License.
-
-   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
-
-*/
-
-#include "ghost.h"
-#include "util.h"
-#include "socket.h"
-
-#include <string.h>
-
-#ifndef WIN32
- int GetLastError( ) { return errno; }
-#endif
-
-//
-// CSocket
-//
-
-CSocket :: CSocket( ) :  m_Socket( INVALID_SOCKET ), m_HasError( false ), m_Error( 0 )
-{
-        memset( &m_SIN, 0, sizeof( m_SIN ) );
-}
-
-CSocket :: CSocket( SOCKET nSocket, struct sockaddr_in nSIN ) : m_Socket( nSocket ), m_SIN( nSIN ), m_HasError( false ), m_Error( 0 )
-{
-
-}
-
-CSocket :: ~CSocket( )
-{
-	if( m_Socket != INVALID_SOCKET )
-		closesocket( m_Socket );
-}
-
-BYTEARRAY CSocket :: GetPort( )
-{
-	return UTIL_CreateByteArray( m_SIN.sin_port, false );
-}
-
-BYTEARRAY CSocket :: GetIP( )
-{
-	return UTIL_CreateByteArray( (uint32_t)m_SIN.sin_addr.s_addr, false );
-}
-
-string CSocket :: GetIPString( )
-{
-	return inet_ntoa( m_SIN.sin_addr );
-}
-
-string CSocket :: GetErrorString( )
-{
-	if( !m_HasError )
-		return "NO ERROR";
-
-	switch( m_Error )
-	{
-	case EWOULDBLOCK: return "EWOULDBLOCK";
-	case EINPROGRESS: return "EINPROGRESS";
-	case EALREADY: return "EALREADY";
-	case ENOTSOCK: return "ENOTSOCK";
-	case EDESTADDRREQ: return "EDESTADDRREQ";
-	case EMSGSIZE: return "EMSGSIZE";
-	case EPROTOTYPE: return "EPROTOTYPE";
-	case ENOPROTOOPT: return "ENOPROTOOPT";
-	case EPROTONOSUPPORT: return "EPROTONOSUPPORT";
-	case ESOCKTNOSUPPORT: return "ESOCKTNOSUPPORT";
-	case EOPNOTSUPP: return "EOPNOTSUPP";
-	case EPFNOSUPPORT: return "EPFNOSUPPORT";
-	case EAFNOSUPPORT: return "EAFNOSUPPORT";
-	case EADDRINUSE: return "EADDRINUSE";
-	case EADDRNOTAVAIL: return "EADDRNOTAVAIL";
-	case ENETDOWN: return "ENETDOWN";
-	case ENETUNREACH: return "ENETUNREACH";
-	case ENETRESET: return "ENETRESET";
-	case ECONNABORTED: return "ECONNABORTED";
-	case ECONNRESET: return "ECONNRESET";
-	case ENOBUFS: return "ENOBUFS";
-	case EISCONN: return "EISCONN";
-	case ENOTCONN: return "ENOTCONN";
-	case ESHUTDOWN: return "ESHUTDOWN";
-	case ETOOMANYREFS: return "ETOOMANYREFS";
-	case ETIMEDOUT: return "ETIMEDOUT";
-	case ECONNREFUSED: return "ECONNREFUSED";
-	case ELOOP: return "ELOOP";
-	case ENAMETOOLONG: return "ENAMETOOLONG";
-	case EHOSTDOWN: return "EHOSTDOWN";
-	case EHOSTUNREACH: return "EHOSTUNREACH";
-	case ENOTEMPTY: return "ENOTEMPTY";
-	case EUSERS: return "EUSERS";
-	case EDQUOT: return "EDQUOT";
-	case ESTALE: return "ESTALE";
-	case EREMOTE: return "EREMOTE";
-	}
-
-	return "UNKNOWN ERROR (" + UTIL_ToString( m_Error ) + ")";
-}
-
-void CSocket :: SetFD( fd_set *fd, fd_set *send_fd, int *nfds )
-{
-	if( m_Socket == INVALID_SOCKET )
-		return;
-
-	FD_SET( m_Socket, fd );
-	FD_SET( m_Socket, send_fd );
-
-#ifndef WIN32
-	if( m_Socket > *nfds )
-		*nfds = m_Socket;
-#endif
-}
-
-void CSocket :: Allocate( int type )
-{
-	m_Socket = socket( AF_INET, type, 0 );
-
-	if( m_Socket == INVALID_SOCKET )
-	{
-		m_HasError = true;
-		m_Error = GetLastError( );
-		CONSOLE_Print( "[SOCKET] error (socket) - " + GetErrorString( ) );
-		return;
-	}
-}
-
-void CSocket :: Reset( )
-{
-	if( m_Socket != INVALID_SOCKET )
-		closesocket( m_Socket );
-
-	m_Socket = INVALID_SOCKET;
-	memset( &m_SIN, 0, sizeof( m_SIN ) );
-	m_HasError = false;
-	m_Error = 0;
-}
-
-//
-// CTCPSocket
-//
-
-CTCPSocket :: CTCPSocket( ) : CSocket( ), m_Connected( false ), m_LastRecv( GetTime( ) ), m_LastSend( GetTime( ) )
-{
-	Allocate( SOCK_STREAM );
-
-	// make socket non blocking
-
-#ifdef WIN32
-	int iMode = 1;
-	ioctlsocket( m_Socket, FIONBIO, (u_long FAR *)&iMode );
-#else
-	fcntl( m_Socket, F_SETFL, fcntl( m_Socket, F_GETFL ) | O_NONBLOCK );
-#endif
-}
-
-CTCPSocket :: CTCPSocket( SOCKET nSocket, struct sockaddr_in nSIN ) : CSocket( nSocket, nSIN )
-{
-	m_Connected = true;
-	m_LastRecv = GetTime( );
-	m_LastSend = GetTime( );
-
-	// make socket non blocking
-
-#ifdef WIN32
-	int iMode = 1;
-	ioctlsocket( m_Socket, FIONBIO, (u_long FAR *)&iMode );
-#else
-	fcntl( m_Socket, F_SETFL, fcntl( m_Socket, F_GETFL ) | O_NONBLOCK );
-#endif
-}
-
-CTCPSocket :: ~CTCPSocket( )
-{
-
-}
-
-void CTCPSocket :: Reset( )
-{
-	CSocket :: Reset( );
-
-	Allocate( SOCK_STREAM );
-	m_Connected = false;
-	m_RecvBuffer.clear( );
-	m_SendBuffer.clear( );
-	m_LastRecv = GetTime( );
-	m_LastSend = GetTime( );
-
-	// make socket non blocking
-
-#ifdef WIN32
-	int iMode = 1;
-	ioctlsocket( m_Socket, FIONBIO, (u_long FAR *)&iMode );
-#else
-	fcntl( m_Socket, F_SETFL, fcntl( m_Socket, F_GETFL ) | O_NONBLOCK );
-#endif
-
-	if( !m_LogFile.empty( ) )
-	{
-		ofstream Log;
-		Log.open( m_LogFile.c_str( ), ios :: app );
-
-		if( !Log.fail( ) )
-		{
-			Log << "----------RESET----------" << endl;
-			Log.close( );
-		}
-	}
-}
-
-void CTCPSocket :: PutBytes( string bytes )
-{
-	m_SendBuffer += bytes;
-}
-
-void CTCPSocket :: PutBytes( BYTEARRAY bytes )
-{
-	m_SendBuffer += string( bytes.begin( ), bytes.end( ) );
-}
-
-void CTCPSocket :: DoRecv( fd_set *fd )
-{
-	if( m_Socket == INVALID_SOCKET || m_HasError || !m_Connected )
-		return;
-
-	if( FD_ISSET( m_Socket, fd ) )
-	{
-		// data is waiting, receive it
-
-		char buffer[1024];
-		int c = recv( m_Socket, buffer, 1024, 0 );
-		
-		if( c > 0 )
-		{
-			// success! add the received data to the buffer
-
-			if( !m_LogFile.empty( ) )
-			{
-				ofstream Log;
-				Log.open( m_LogFile.c_str( ), ios :: app );
-
-				if( !Log.fail( ) )
-				{
-					Log << "					RECEIVE <<< " << UTIL_ByteArrayToHexString( UTIL_CreateByteArray( (unsigned char *)buffer, c ) ) << endl;
-					Log.close( );
-				}
-			}
-
-			m_RecvBuffer += string( buffer, c );
-			m_LastRecv = GetTime( );
-		}
-		else if( c == SOCKET_ERROR && GetLastError( ) != EWOULDBLOCK )
-		{
-			// receive error
-
-			m_HasError = true;
-			m_Error = GetLastError( );
-			CONSOLE_Print( "[TCPSOCKET] error (recv) - " + GetErrorString( ) );
-			return;
-		}
-		else if( c == 0 )
-		{
-			// the other end closed the connection
-
-			CONSOLE_Print( "[TCPSOCKET] closed by remote host" );
-			m_Connected = false;
-		}
-	}
-}
-
-void CTCPSocket :: DoSend( fd_set *send_fd )
-{
-	if( m_Socket == INVALID_SOCKET || m_HasError || !m_Connected || m_SendBuffer.empty( ) )
-		return;
-
-	if( FD_ISSET( m_Socket, send_fd ) )
-	{
-		// socket is ready, send it
-
-		int s = send( m_Socket, m_SendBuffer.c_str( ), (int)m_SendBuffer.size( ), MSG_NOSIGNAL );
-		
-		if( s > 0 )
-		{
-			// success! only some of the data may have been sent, remove it from the buffer
-
-			if( !m_LogFile.empty( ) )
-			{
-				ofstream Log;
-				Log.open( m_LogFile.c_str( ), ios :: app );
-
-				if( !Log.fail( ) )
-				{
-					Log << "SEND >>> " << UTIL_ByteArrayToHexString( BYTEARRAY( m_SendBuffer.begin( ), m_SendBuffer.begin( ) + s ) ) << endl;
-					Log.close( );
-				}
-			}
-
-			m_SendBuffer = m_SendBuffer.substr( s );
-			m_LastSend = GetTime( );
-		}
-		else if( s == SOCKET_ERROR && GetLastError( ) != EWOULDBLOCK )
-		{
-			// send error
-
-			m_HasError = true;
-			m_Error = GetLastError( );
-			CONSOLE_Print( "[TCPSOCKET] error (send) - " + GetErrorString( ) );
-			return;
-		}
-	}
-}
-
-void CTCPSocket :: Disconnect( )
-{
-	if( m_Socket != INVALID_SOCKET )
-		shutdown( m_Socket, SHUT_RDWR );
-
-	m_Connected = false;
-}
-
-void CTCPSocket :: SetNoDelay( bool noDelay )
-{
-	int OptVal = 0;
-
-	if( noDelay )
-		OptVal = 1;
-
-	setsockopt( m_Socket, IPPROTO_TCP, TCP_NODELAY, (const char *)&OptVal, sizeof( int ) );
-}
-
-//
-// CTCPClient
-//
-
-CTCPClient :: CTCPClient( ) : CTCPSocket( ), m_Connecting( false )
-{
-
-}
-
-CTCPClient :: ~CTCPClient( )
-{
-
-}
-
-void CTCPClient :: Reset( )
-{
-	CTCPSocket :: Reset( );
-	m_Connecting = false;
-}
-
-void CTCPClient :: Disconnect( )
-{
-	CTCPSocket :: Disconnect( );
-	m_Connecting = false;
-}
-
-void CTCPClient :: Connect( string localaddress, string address, uint16_t port )
-{
-	if( m_Socket == INVALID_SOCKET || m_HasError || m_Connecting || m_Connected )
-		return;
-
-	if( !localaddress.empty( ) )
-	{
-		struct sockaddr_in LocalSIN;
-		memset( &LocalSIN, 0, sizeof( LocalSIN ) );
-		LocalSIN.sin_family = AF_INET;
-
-		if( ( LocalSIN.sin_addr.s_addr = inet_addr( localaddress.c_str( ) ) ) == INADDR_NONE )
-			LocalSIN.sin_addr.s_addr = INADDR_ANY;
-
-		LocalSIN.sin_port = htons( 0 );
-
-		if( bind( m_Socket, (struct sockaddr *)&LocalSIN, sizeof( LocalSIN ) ) == SOCKET_ERROR )
-		{
-			m_HasError = true;
-			m_Error = GetLastError( );
-			CONSOLE_Print( "[TCPCLIENT] error (bind) - " + GetErrorString( ) );
-			return;
-		}
-	}
-
-	// get IP address
-
-	struct hostent *HostInfo;
-	uint32_t HostAddress;
-	HostInfo = gethostbyname( address.c_str( ) );
-
-	if( !HostInfo )
-	{
-		m_HasError = true;
-		// m_Error = h_error;
-		CONSOLE_Print( "[TCPCLIENT] error (gethostbyname)" );
-		return;
-	}
-
-	memcpy( &HostAddress, HostInfo->h_addr, HostInfo->h_length );
-
-	// connect
-
-	m_SIN.sin_family = AF_INET;
-	m_SIN.sin_addr.s_addr = HostAddress;
-	m_SIN.sin_port = htons( port );
-
-	if( connect( m_Socket, (struct sockaddr *)&m_SIN, sizeof( m_SIN ) ) == SOCKET_ERROR )
-	{
-		if( GetLastError( ) != EINPROGRESS && GetLastError( ) != EWOULDBLOCK )
-		{
-			// connect error
-
-			m_HasError = true;
-			m_Error = GetLastError( );
-			CONSOLE_Print( "[TCPCLIENT] error (connect) - " + GetErrorString( ) );
-			return;
-		}
-	}
-
-	m_Connecting = true;
-}
-
-bool CTCPClient :: CheckConnect( )
-{
-	if( m_Socket == INVALID_SOCKET || m_HasError || !m_Connecting )
-		return false;
-
-	fd_set fd;
-	FD_ZERO( &fd );
-	FD_SET( m_Socket, &fd );
-
-	struct timeval tv;
-	tv.tv_sec = 0;
-	tv.tv_usec = 0;
-
-	// check if the socket is connected
-
-#ifdef WIN32
-	if( select( 1, NULL, &fd, NULL, &tv ) == SOCKET_ERROR )
-#else
-	if( select( m_Socket + 1, NULL, &fd, NULL, &tv ) == SOCKET_ERROR )
-#endif
-	{
-		m_HasError = true;
-		m_Error = GetLastError( );
-		return false;
-	}
-
-	if( FD_ISSET( m_Socket, &fd ) )
-	{
-		m_Connecting = false;
-		m_Connected = true;
-		return true;
-	}
-
-	return false;
-}
-
-//
-// CTCPServer
-//
-
-CTCPServer :: CTCPServer( ) : CTCPSocket( )
-{
-	// set the socket to reuse the address in case it hasn't been released yet
-
-	int optval = 1;
-
-#ifdef WIN32
-	setsockopt( m_Socket, SOL_SOCKET, SO_REUSEADDR, (const char *)&optval, sizeof( int ) );
-#else
-	setsockopt( m_Socket, SOL_SOCKET, SO_REUSEADDR, (const void *)&optval, sizeof( int ) );
-#endif
-}
-
-CTCPServer :: ~CTCPServer( )
-{
-
-}
-
-bool CTCPServer :: Listen( string address, uint16_t port )
-{
-	if( m_Socket == INVALID_SOCKET || m_HasError )
-		return false;
-
-	m_SIN.sin_family = AF_INET;
-
-	if( !address.empty( ) )
-	{
-		if( ( m_SIN.sin_addr.s_addr = inet_addr( address.c_str( ) ) ) == INADDR_NONE )
-			m_SIN.sin_addr.s_addr = INADDR_ANY;
-	}
-	else
-		m_SIN.sin_addr.s_addr = INADDR_ANY;
-
-	m_SIN.sin_port = htons( port );
-
-	if( bind( m_Socket, (struct sockaddr *)&m_SIN, sizeof( m_SIN ) ) == SOCKET_ERROR )
-	{
-		m_HasError = true;
-		m_Error = GetLastError( );
-		CONSOLE_Print( "[TCPSERVER] error (bind) - " + GetErrorString( ) );
-		return false;
-	}
-
-	// listen, queue length 8
-
-	if( listen( m_Socket, 8 ) == SOCKET_ERROR )
-	{
-		m_HasError = true;
-		m_Error = GetLastError( );
-		CONSOLE_Print( "[TCPSERVER] error (listen) - " + GetErrorString( ) );
-		return false;
-	}
-
-	return true;
-}
-
-CTCPSocket *CTCPServer :: Accept( fd_set *fd )
-{
-	if( m_Socket == INVALID_SOCKET || m_HasError )
-		return NULL;
-
-	if( FD_ISSET( m_Socket, fd ) )
-	{
-		// a connection is waiting, accept it
-
-		struct sockaddr_in Addr;
-		int AddrLen = sizeof( Addr );
-		SOCKET NewSocket;
-
-#ifdef WIN32
-		if( ( NewSocket = accept( m_Socket, (struct sockaddr *)&Addr, &AddrLen ) ) == INVALID_SOCKET )
-#else
-		if( ( NewSocket = accept( m_Socket, (struct sockaddr *)&Addr, (socklen_t *)&AddrLen ) ) == INVALID_SOCKET )
-#endif
-		{
-			// accept error, ignore it
-		}
-		else
-		{
-			// success! return the new socket
-
-			return new CTCPSocket( NewSocket, Addr );
-		}
-	}
-
-	return NULL;
-}
-
-//
-// CUDPSocket
-//
-
-CUDPSocket :: CUDPSocket( ) : CSocket( )
-{
-	Allocate( SOCK_DGRAM );
-
-	// enable broadcast support
-
-	int OptVal = 1;
-	setsockopt( m_Socket, SOL_SOCKET, SO_BROADCAST, (const char *)&OptVal, sizeof( int ) );
-	
-	// set default broadcast target
-	m_BroadcastTarget.s_addr = INADDR_BROADCAST;
-}
-
-CUDPSocket :: ~CUDPSocket( )
-{
-
-}
-
-bool CUDPSocket :: SendTo( struct sockaddr_in sin, BYTEARRAY message )
-{
-	if( m_Socket == INVALID_SOCKET || m_HasError )
-		return false;
-
-	string MessageString = string( message.begin( ), message.end( ) );
-
-	if( sendto( m_Socket, MessageString.c_str( ), MessageString.size( ), 0, (struct sockaddr *)&sin, sizeof( sin ) ) == -1 )
-		return false;
-
-	return true;
-}
-
-bool CUDPSocket :: SendTo( string address, uint16_t port, BYTEARRAY message )
-{
-	if( m_Socket == INVALID_SOCKET || m_HasError )
-		return false;
-
-	// get IP address
-
-	struct hostent *HostInfo;
-	uint32_t HostAddress;
-	HostInfo = gethostbyname( address.c_str( ) );
-
-	if( !HostInfo )
-	{
-		m_HasError = true;
-		// m_Error = h_error;
-		CONSOLE_Print( "[UDPSOCKET] error (gethostbyname)" );
-		return false;
-	}
-
-	memcpy( &HostAddress, HostInfo->h_addr, HostInfo->h_length );
-	struct sockaddr_in sin;
-	sin.sin_family = AF_INET;
-	sin.sin_addr.s_addr = HostAddress;
-	sin.sin_port = htons( port );
-
-	return SendTo( sin, message );
-}
-
-bool CUDPSocket :: Broadcast( uint16_t port, BYTEARRAY message )
-{
-	if( m_Socket == INVALID_SOCKET || m_HasError )
-		return false;
-
-	struct sockaddr_in sin;
-	sin.sin_family = AF_INET;
-	sin.sin_addr.s_addr = m_BroadcastTarget.s_addr;
-	sin.sin_port = htons( port );
-
-	string MessageString = string( message.begin( ), message.end( ) );
-
-	if( sendto( m_Socket, MessageString.c_str( ), MessageString.size( ), 0, (struct sockaddr *)&sin, sizeof( sin ) ) == -1 )
-	{
-		CONSOLE_Print( "[UDPSOCKET] failed to broadcast packet (port " + UTIL_ToString( port ) + ", size " + UTIL_ToString( MessageString.size( ) ) + " bytes)" );
-		return false;
-	}
-
-	return true;
-}
-
-void CUDPSocket :: SetBroadcastTarget( string subnet )
-{
-	if( subnet.empty( ) )
-	{
-		CONSOLE_Print( "[UDPSOCKET] using default broadcast target" );
-		m_BroadcastTarget.s_addr = INADDR_BROADCAST;
-	}
-	else
-	{
-		// this function does not check whether the given subnet is a valid subnet the user is on
-		// convert string representation of ip/subnet to in_addr
-
-		CONSOLE_Print( "[UDPSOCKET] using broadcast target [" + subnet + "]" );
-		m_BroadcastTarget.s_addr = inet_addr( subnet.c_str( ) );
-
-		// if conversion fails, inet_addr( ) returns INADDR_NONE
-
-		if( m_BroadcastTarget.s_addr == INADDR_NONE )
-		{
-			CONSOLE_Print( "[UDPSOCKET] invalid broadcast target, using default broadcast target" );
-			m_BroadcastTarget.s_addr = INADDR_BROADCAST;
-		}
-	}
-}
-
-void CUDPSocket :: SetDontRoute( bool dontRoute )
-{
-	int OptVal = 0;
-
-	if( dontRoute )
-		OptVal = 1;
-
-	// don't route packets; make them ignore routes set by routing table and send them to the interface
-	// belonging to the target address directly
-
-	setsockopt( m_Socket, SOL_SOCKET, SO_DONTROUTE, (const char *)&OptVal, sizeof( int ) );
-}
-
-//
-// CUDPServer
-//
-
-CUDPServer :: CUDPServer( ) : CUDPSocket( )
-{
-	// make socket non blocking
-
-#ifdef WIN32
-	int iMode = 1;
-	ioctlsocket( m_Socket, FIONBIO, (u_long FAR *)&iMode );
-#else
-	fcntl( m_Socket, F_SETFL, fcntl( m_Socket, F_GETFL ) | O_NONBLOCK );
-#endif
-
-	// set the socket to reuse the address
-	// with UDP sockets this allows more than one program to listen on the same port
-
-	int optval = 1;
-
-#ifdef WIN32
-	setsockopt( m_Socket, SOL_SOCKET, SO_REUSEADDR, (const char *)&optval, sizeof( int ) );
-#else
-	setsockopt( m_Socket, SOL_SOCKET, SO_REUSEADDR, (const void *)&optval, sizeof( int ) );
-#endif
-}
-
-CUDPServer :: ~CUDPServer( )
-{
-
-}
-
-bool CUDPServer :: Bind( struct sockaddr_in sin )
-{
-	if( m_Socket == INVALID_SOCKET || m_HasError )
-		return false;
-
-	m_SIN = sin;
-
-	if( bind( m_Socket, (struct sockaddr *)&m_SIN, sizeof( m_SIN ) ) == SOCKET_ERROR )
-	{
-		m_HasError = true;
-		m_Error = GetLastError( );
-		CONSOLE_Print( "[UDPSERVER] error (bind) - " + GetErrorString( ) );
-		return false;
-	}
-
-	return true;
-}
-
-bool CUDPServer :: Bind( string address, uint16_t port )
-{
-	if( m_Socket == INVALID_SOCKET || m_HasError )
-		return false;
-
-	struct sockaddr_in sin;
-	sin.sin_family = AF_INET;
-
-	if( !address.empty( ) )
-	{
-		if( ( sin.sin_addr.s_addr = inet_addr( address.c_str( ) ) ) == INADDR_NONE )
-			sin.sin_addr.s_addr = INADDR_ANY;
-	}
-	else
-		sin.sin_addr.s_addr = INADDR_ANY;
-
-	sin.sin_port = htons( port );
-
-	return Bind( sin );
-}
-
-void CUDPServer :: RecvFrom( fd_set *fd, struct sockaddr_in *sin, string *message )
-{
-	if( m_Socket == INVALID_SOCKET || m_HasError || !sin || !message )
-		return;
-
-	int AddrLen = sizeof( *sin );
-
-	if( FD_ISSET( m_Socket, fd ) )
-	{
-		// data is waiting, receive it
-
-		char buffer[1024];
-
-#ifdef WIN32
-		int c = recvfrom( m_Socket, buffer, 1024, 0, (struct sockaddr *)sin, &AddrLen );
-#else
-		int c = recvfrom( m_Socket, buffer, 1024, 0, (struct sockaddr *)sin, (socklen_t *)&AddrLen );
-#endif
-
-		if( c > 0 )
-		{
-			// success!
-
-			*message = string( buffer, c );
-		}
-		else if( c == SOCKET_ERROR && GetLastError( ) != EWOULDBLOCK )
-		{
-			// receive error
-
-			m_HasError = true;
-			m_Error = GetLastError( );
-			CONSOLE_Print( "[UDPSERVER] error (recvfrom) - " + GetErrorString( ) );
-		}
-	}
-}
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#include "ghost.h"
+#include "util.h"
+#include "socket.h"
+
+#include <string.h>
+
+#include <boost/thread.hpp>
+
+#ifndef WIN32
+ int GetLastError( ) { return errno; }
+#endif
+
+CSocketPoller *gSocketPoller = NULL;
+
+// the thread's socket poller is owned by whoever set it so there's nothing to clean up when the thread exits
+
+static void KeepThreadSocketPoller( CSocketPoller * )
+{
+
+}
+
+static boost :: thread_specific_ptr<CSocketPoller> gThreadSocketPoller( KeepThreadSocketPoller );
+
+CSocketPoller *GetSocketPoller( )
+{
+	CSocketPoller *Poller = gThreadSocketPoller.get( );
+	return Poller ? Poller : gSocketPoller;
+}
+
+void SetThreadSocketPoller( CSocketPoller *poller )
+{
+	gThreadSocketPoller.reset( poller );
+}
+
+//
+// CRingBuffer
+//
+
+CRingBuffer :: CRingBuffer( uint32_t nCapacity ) : m_Buffer( NULL ), m_Capacity( 1 ), m_Start( 0 ), m_Size( 0 )
+{
+	while( m_Capacity < nCapacity )
+		m_Capacity <<= 1;
+
+	m_Buffer = new unsigned char[m_Capacity];
+}
+
+CRingBuffer :: ~CRingBuffer( )
+{
+	delete [] m_Buffer;
+}
+
+void CRingBuffer :: Clear( )
+{
+	m_Start = 0;
+	m_Size = 0;
+}
+
+void CRingBuffer :: Reserve( uint32_t length )
+{
+	// make sure at least length bytes can be appended without growing
+
+	if( GetFree( ) >= length )
+		return;
+
+	uint32_t NewCapacity = m_Capacity;
+
+	while( NewCapacity - m_Size < length )
+		NewCapacity <<= 1;
+
+	// this is the only time the stored data is moved, it's copied to the start of the new allocation
+
+	unsigned char *NewBuffer = new unsigned char[NewCapacity];
+	unsigned char *Data[2];
+	uint32_t Length[2];
+	uint32_t Regions = GetReadRegions( Data, Length );
+	uint32_t Offset = 0;
+
+	for( uint32_t i = 0; i < Regions; i++ )
+	{
+		memcpy( NewBuffer + Offset, Data[i], Length[i] );
+		Offset += Length[i];
+	}
+
+	delete [] m_Buffer;
+	m_Buffer = NewBuffer;
+	m_Capacity = NewCapacity;
+	m_Start = 0;
+}
+
+void CRingBuffer :: Append( const unsigned char *data, uint32_t length )
+{
+	if( length == 0 )
+		return;
+
+	Reserve( length );
+	unsigned char *Data[2];
+	uint32_t Length[2];
+	uint32_t Regions = GetWriteRegions( Data, Length );
+	uint32_t Offset = 0;
+
+	for( uint32_t i = 0; i < Regions && Offset < length; i++ )
+	{
+		uint32_t Copy = length - Offset < Length[i] ? length - Offset : Length[i];
+		memcpy( Data[i], data + Offset, Copy );
+		Offset += Copy;
+	}
+
+	m_Size += length;
+}
+
+void CRingBuffer :: Consume( uint32_t length )
+{
+	if( length >= m_Size )
+	{
+		// rewind the cursors when the buffer is emptied so the next data starts out contiguous
+
+		Clear( );
+		return;
+	}
+
+	m_Start = ( m_Start + length ) & ( m_Capacity - 1 );
+	m_Size -= length;
+}
+
+void CRingBuffer :: Commit( uint32_t length )
+{
+	// data was written directly into the write regions (e.g. by readv), move the write cursor past it
+
+	if( length > GetFree( ) )
+		length = GetFree( );
+
+	m_Size += length;
+}
+
+uint32_t CRingBuffer :: GetReadRegions( unsigned char **data, uint32_t *length )
+{
+	if( m_Size == 0 )
+		return 0;
+
+	if( m_Start + m_Size <= m_Capacity )
+	{
+		data[0] = m_Buffer + m_Start;
+		length[0] = m_Size;
+		return 1;
+	}
+
+	data[0] = m_Buffer + m_Start;
+	length[0] = m_Capacity - m_Start;
+	data[1] = m_Buffer;
+	length[1] = m_Size - length[0];
+	return 2;
+}
+
+uint32_t CRingBuffer :: GetWriteRegions( unsigned char **data, uint32_t *length )
+{
+	if( m_Size == m_Capacity )
+		return 0;
+
+	uint32_t End = ( m_Start + m_Size ) & ( m_Capacity - 1 );
+
+	if( End < m_Start )
+	{
+		// the stored data wraps so the free space is the gap between the write cursor and the read cursor
+
+		data[0] = m_Buffer + End;
+		length[0] = m_Start - End;
+		return 1;
+	}
+
+	data[0] = m_Buffer + End;
+	length[0] = m_Capacity - End;
+
+	if( m_Start == 0 )
+		return 1;
+
+	data[1] = m_Buffer;
+	length[1] = m_Start;
+	return 2;
+}
+
+BYTEARRAY CRingBuffer :: GetBytes( uint32_t length )
+{
+	// copy the first length bytes out of the buffer without consuming them
+
+	BYTEARRAY Bytes;
+	unsigned char *Data[2];
+	uint32_t Length[2];
+	uint32_t Regions = GetReadRegions( Data, Length );
+
+	for( uint32_t i = 0; i < Regions && Bytes.size( ) < length; i++ )
+	{
+		uint32_t Copy = length - Bytes.size( ) < Length[i] ? length - Bytes.size( ) : Length[i];
+		Bytes.insert( Bytes.end( ), Data[i], Data[i] + Copy );
+	}
+
+	return Bytes;
+}
+
+unsigned char *CRingBuffer :: GetData( )
+{
+	// return the stored data as one contiguous block
+	// if the data currently wraps around the end of the allocation it has to be rotated to the front first
+	// this only happens after the write cursor wraps which is at most once every m_Capacity bytes
+
+	if( m_Start + m_Size > m_Capacity )
+	{
+		unsigned char *NewBuffer = new unsigned char[m_Capacity];
+		uint32_t First = m_Capacity - m_Start;
+		memcpy( NewBuffer, m_Buffer + m_Start, First );
+		memcpy( NewBuffer + First, m_Buffer, m_Size - First );
+		delete [] m_Buffer;
+		m_Buffer = NewBuffer;
+		m_Start = 0;
+	}
+
+	return m_Buffer + m_Start;
+}
+
+//
+// CSocket
+//
+
+CSocket :: CSocket( ) :  m_Socket( INVALID_SOCKET ), m_HasError( false ), m_Error( 0 ), m_Poller( NULL ), m_Readable( false )
+{
+        memset( &m_SIN, 0, sizeof( m_SIN ) );
+}
+
+CSocket :: CSocket( SOCKET nSocket, struct sockaddr_in nSIN ) : m_Socket( nSocket ), m_SIN( nSIN ), m_HasError( false ), m_Error( 0 ), m_Poller( NULL ), m_Readable( false )
+{
+
+}
+
+CSocket :: ~CSocket( )
+{
+	Unpoll( );
+
+	if( m_Socket != INVALID_SOCKET )
+		closesocket( m_Socket );
+}
+
+BYTEARRAY CSocket :: GetPort( )
+{
+	return UTIL_CreateByteArray( m_SIN.sin_port, false );
+}
+
+BYTEARRAY CSocket :: GetIP( )
+{
+	return UTIL_CreateByteArray( (uint32_t)m_SIN.sin_addr.s_addr, false );
+}
+
+string CSocket :: GetIPString( )
+{
+	return inet_ntoa( m_SIN.sin_addr );
+}
+
+string CSocket :: GetErrorString( )
+{
+	if( !m_HasError )
+		return "NO ERROR";
+
+	switch( m_Error )
+	{
+	case EWOULDBLOCK: return "EWOULDBLOCK";
+	case EINPROGRESS: return "EINPROGRESS";
+	case EALREADY: return "EALREADY";
+	case ENOTSOCK: return "ENOTSOCK";
+	case EDESTADDRREQ: return "EDESTADDRREQ";
+	case EMSGSIZE: return "EMSGSIZE";
+	case EPROTOTYPE: return "EPROTOTYPE";
+	case ENOPROTOOPT: return "ENOPROTOOPT";
+	case EPROTONOSUPPORT: return "EPROTONOSUPPORT";
+	case ESOCKTNOSUPPORT: return "ESOCKTNOSUPPORT";
+	case EOPNOTSUPP: return "EOPNOTSUPP";
+	case EPFNOSUPPORT: return "EPFNOSUPPORT";
+	case EAFNOSUPPORT: return "EAFNOSUPPORT";
+	case EADDRINUSE: return "EADDRINUSE";
+	case EADDRNOTAVAIL: return "EADDRNOTAVAIL";
+	case ENETDOWN: return "ENETDOWN";
+	case ENETUNREACH: return "ENETUNREACH";
+	case ENETRESET: return "ENETRESET";
+	case ECONNABORTED: return "ECONNABORTED";
+	case ECONNRESET: return "ECONNRESET";
+	case ENOBUFS: return "ENOBUFS";
+	case EISCONN: return "EISCONN";
+	case ENOTCONN: return "ENOTCONN";
+	case ESHUTDOWN: return "ESHUTDOWN";
+	case ETOOMANYREFS: return "ETOOMANYREFS";
+	case ETIMEDOUT: return "ETIMEDOUT";
+	case ECONNREFUSED: return "ECONNREFUSED";
+	case ELOOP: return "ELOOP";
+	case ENAMETOOLONG: return "ENAMETOOLONG";
+	case EHOSTDOWN: return "EHOSTDOWN";
+	case EHOSTUNREACH: return "EHOSTUNREACH";
+	case ENOTEMPTY: return "ENOTEMPTY";
+	case EUSERS: return "EUSERS";
+	case EDQUOT: return "EDQUOT";
+	case ESTALE: return "ESTALE";
+	case EREMOTE: return "EREMOTE";
+	}
+
+	return "UNKNOWN ERROR (" + UTIL_ToString( m_Error ) + ")";
+}
+
+bool CSocket :: IsReadable( fd_set *fd )
+{
+	if( m_Socket == INVALID_SOCKET )
+		return false;
+
+	// a NULL fd_set means we're using a socket poller and it has already flagged the socket for us
+
+	if( !fd )
+		return m_Readable;
+
+	return FD_ISSET( m_Socket, fd );
+}
+
+bool CSocket :: IsWritable( fd_set *send_fd )
+{
+	if( m_Socket == INVALID_SOCKET )
+		return false;
+
+	// the socket poller only waits for incoming data
+	// all our sockets are non blocking so we just try to send and let EWOULDBLOCK sort it out
+
+	if( !send_fd )
+		return true;
+
+	return FD_ISSET( m_Socket, send_fd );
+}
+
+void CSocket :: SetFD( fd_set *fd, fd_set *send_fd, int *nfds )
+{
+	if( m_Socket == INVALID_SOCKET )
+		return;
+
+	FD_SET( m_Socket, fd );
+	FD_SET( m_Socket, send_fd );
+
+#ifndef WIN32
+	if( m_Socket > *nfds )
+		*nfds = m_Socket;
+#endif
+}
+
+void CSocket :: Allocate( int type )
+{
+	m_Socket = socket( AF_INET, type, 0 );
+
+	if( m_Socket == INVALID_SOCKET )
+	{
+		m_HasError = true;
+		m_Error = GetLastError( );
+		LOG_Print( LOGCAT_NETWORK, LOGLEVEL_ERROR, "[SOCKET] error (socket) - " + GetErrorString( ) );
+		return;
+	}
+}
+
+void CSocket :: Poll( )
+{
+	// register the socket with the socket poller so we get told when data is waiting
+	// this is done once per socket (when it's connected, listening, or bound) instead of on every update
+
+	CSocketPoller *Poller = GetSocketPoller( );
+
+	if( Poller && !m_Poller && m_Socket != INVALID_SOCKET && !m_HasError )
+		Poller->Add( this );
+}
+
+void CSocket :: Unpoll( )
+{
+	// this has to happen on the thread that owns the poller we're registered with (see CBaseGame :: UnpollSockets)
+
+	if( m_Poller )
+		m_Poller->Remove( this );
+
+	m_Readable = false;
+}
+
+void CSocket :: Reset( )
+{
+	Unpoll( );
+
+	if( m_Socket != INVALID_SOCKET )
+		closesocket( m_Socket );
+
+	m_Socket = INVALID_SOCKET;
+	memset( &m_SIN, 0, sizeof( m_SIN ) );
+	m_HasError = false;
+	m_Error = 0;
+}
+
+//
+// CTCPSocket
+//
+
+CTCPSocket :: CTCPSocket( ) : CSocket( ), m_Connected( false ), m_LastRecv( GetTime( ) ), m_LastSend( GetTime( ) )
+{
+	Allocate( SOCK_STREAM );
+
+	// make socket non blocking
+
+#ifdef WIN32
+	int iMode = 1;
+	ioctlsocket( m_Socket, FIONBIO, (u_long FAR *)&iMode );
+#else
+	fcntl( m_Socket, F_SETFL, fcntl( m_Socket, F_GETFL ) | O_NONBLOCK );
+#endif
+}
+
+CTCPSocket :: CTCPSocket( SOCKET nSocket, struct sockaddr_in nSIN ) : CSocket( nSocket, nSIN )
+{
+	m_Connected = true;
+	m_LastRecv = GetTime( );
+	m_LastSend = GetTime( );
+
+	// make socket non blocking
+
+#ifdef WIN32
+	int iMode = 1;
+	ioctlsocket( m_Socket, FIONBIO, (u_long FAR *)&iMode );
+#else
+	fcntl( m_Socket, F_SETFL, fcntl( m_Socket, F_GETFL ) | O_NONBLOCK );
+#endif
+
+	Poll( );
+}
+
+CTCPSocket :: ~CTCPSocket( )
+{
+
+}
+
+void CTCPSocket :: Reset( )
+{
+	CSocket :: Reset( );
+
+	Allocate( SOCK_STREAM );
+	m_Connected = false;
+	m_RecvBuffer.Clear( );
+	m_SendBuffer.Clear( );
+	m_LastRecv = GetTime( );
+	m_LastSend = GetTime( );
+
+	// make socket non blocking
+
+#ifdef WIN32
+	int iMode = 1;
+	ioctlsocket( m_Socket, FIONBIO, (u_long FAR *)&iMode );
+#else
+	fcntl( m_Socket, F_SETFL, fcntl( m_Socket, F_GETFL ) | O_NONBLOCK );
+#endif
+
+	if( !m_LogFile.empty( ) )
+		LOG_WriteFile( m_LogFile, "----------RESET----------" );
+}
+
+void CTCPSocket :: PutBytes( const string &bytes )
+{
+	m_SendBuffer.Append( bytes );
+}
+
+void CTCPSocket :: PutBytes( const BYTEARRAY &bytes )
+{
+	m_SendBuffer.Append( bytes );
+}
+
+void CTCPSocket :: DoRecv( fd_set *fd )
+{
+	if( m_Socket == INVALID_SOCKET || m_HasError || !m_Connected )
+		return;
+
+	if( IsReadable( fd ) )
+	{
+		// data is waiting, receive it straight into the free space of the receive buffer
+		// the buffer grows if there isn't at least 1 KB free, otherwise we read as much as fits
+
+		m_RecvBuffer.Reserve( 1024 );
+		unsigned char *Data[2];
+		uint32_t Length[2];
+		uint32_t Regions = m_RecvBuffer.GetWriteRegions( Data, Length );
+
+#ifdef WIN32
+		int c = recv( m_Socket, (char *)Data[0], Length[0], 0 );
+#else
+		struct iovec Vec[2];
+
+		for( uint32_t i = 0; i < Regions; i++ )
+		{
+			Vec[i].iov_base = Data[i];
+			Vec[i].iov_len = Length[i];
+		}
+
+		int c = readv( m_Socket, Vec, Regions );
+#endif
+
+		if( c > 0 )
+		{
+			// success! add the received data to the buffer
+
+			if( !m_LogFile.empty( ) )
+			{
+				BYTEARRAY Received( Data[0], Data[0] + ( (uint32_t)c < Length[0] ? c : Length[0] ) );
+
+				if( (uint32_t)c > Length[0] )
+					Received.insert( Received.end( ), Data[1], Data[1] + ( c - Length[0] ) );
+
+				LOG_WriteFile( m_LogFile, "					RECEIVE <<< " + UTIL_ByteArrayToHexString( Received ) );
+			}
+
+			m_RecvBuffer.Commit( c );
+			m_LastRecv = GetTime( );
+		}
+		else if( c == SOCKET_ERROR && GetLastError( ) != EWOULDBLOCK )
+		{
+			// receive error
+
+			m_HasError = true;
+			m_Error = GetLastError( );
+			LOG_Print( LOGCAT_NETWORK, LOGLEVEL_ERROR, "[TCPSOCKET] error (recv) - " + GetErrorString( ) );
+			return;
+		}
+		else if( c == 0 )
+		{
+			// the other end closed the connection
+
+			LOG_Print( LOGCAT_NETWORK, LOGLEVEL_INFO, "[TCPSOCKET] closed by remote host" );
+			m_Connected = false;
+		}
+	}
+}
+
+void CTCPSocket :: DoSend( fd_set *send_fd )
+{
+	if( m_Socket == INVALID_SOCKET || m_HasError || !m_Connected || m_SendBuffer.GetEmpty( ) )
+		return;
+
+	if( IsWritable( send_fd ) )
+	{
+		// socket is ready, send it
+		// if the send buffer wraps around we hand both halves to the kernel at once
+
+		unsigned char *Data[2];
+		uint32_t Length[2];
+		uint32_t Regions = m_SendBuffer.GetReadRegions( Data, Length );
+
+#ifdef WIN32
+		int s = send( m_Socket, (const char *)Data[0], Length[0], MSG_NOSIGNAL );
+#else
+		struct iovec Vec[2];
+
+		for( uint32_t i = 0; i < Regions; i++ )
+		{
+			Vec[i].iov_base = Data[i];
+			Vec[i].iov_len = Length[i];
+		}
+
+		// use sendmsg rather than writev so we can pass MSG_NOSIGNAL
+
+		struct msghdr Msg;
+		memset( &Msg, 0, sizeof( Msg ) );
+		Msg.msg_iov = Vec;
+		Msg.msg_iovlen = Regions;
+		int s = sendmsg( m_Socket, &Msg, MSG_NOSIGNAL );
+#endif
+
+		if( s > 0 )
+		{
+			// success! only some of the data may have been sent, advance the read cursor past it
+
+			if( !m_LogFile.empty( ) )
+				LOG_WriteFile( m_LogFile, "SEND >>> " + UTIL_ByteArrayToHexString( m_SendBuffer.GetBytes( s ) ) );
+
+			m_SendBuffer.Consume( s );
+			m_LastSend = GetTime( );
+		}
+		else if( s == SOCKET_ERROR && GetLastError( ) != EWOULDBLOCK )
+		{
+			// send error
+
+			m_HasError = true;
+			m_Error = GetLastError( );
+			LOG_Print( LOGCAT_NETWORK, LOGLEVEL_ERROR, "[TCPSOCKET] error (send) - " + GetErrorString( ) );
+			return;
+		}
+	}
+}
+
+void CTCPSocket :: Disconnect( )
+{
+	// a shutdown socket is always readable so stop polling it
+
+	Unpoll( );
+
+	if( m_Socket != INVALID_SOCKET )
+		shutdown( m_Socket, SHUT_RDWR );
+
+	m_Connected = false;
+}
+
+void CTCPSocket :: SetNoDelay( bool noDelay )
+{
+	int OptVal = 0;
+
+	if( noDelay )
+		OptVal = 1;
+
+	setsockopt( m_Socket, IPPROTO_TCP, TCP_NODELAY, (const char *)&OptVal, sizeof( int ) );
+}
+
+//
+// CTCPClient
+//
+
+CTCPClient :: CTCPClient( ) : CTCPSocket( ), m_Connecting( false )
+{
+
+}
+
+CTCPClient :: ~CTCPClient( )
+{
+
+}
+
+void CTCPClient :: Reset( )
+{
+	CTCPSocket :: Reset( );
+	m_Connecting = false;
+}
+
+void CTCPClient :: Disconnect( )
+{
+	CTCPSocket :: Disconnect( );
+	m_Connecting = false;
+}
+
+void CTCPClient :: Connect( string localaddress, string address, uint16_t port )
+{
+	if( m_Socket == INVALID_SOCKET || m_HasError || m_Connecting || m_Connected )
+		return;
+
+	if( !localaddress.empty( ) )
+	{
+		struct sockaddr_in LocalSIN;
+		memset( &LocalSIN, 0, sizeof( LocalSIN ) );
+		LocalSIN.sin_family = AF_INET;
+
+		if( ( LocalSIN.sin_addr.s_addr = inet_addr( localaddress.c_str( ) ) ) == INADDR_NONE )
+			LocalSIN.sin_addr.s_addr = INADDR_ANY;
+
+		LocalSIN.sin_port = htons( 0 );
+
+		if( bind( m_Socket, (struct sockaddr *)&LocalSIN, sizeof( LocalSIN ) ) == SOCKET_ERROR )
+		{
+			m_HasError = true;
+			m_Error = GetLastError( );
+			LOG_Print( LOGCAT_NETWORK, LOGLEVEL_ERROR, "[TCPCLIENT] error (bind) - " + GetErrorString( ) );
+			return;
+		}
+	}
+
+	// get IP address
+
+	struct hostent *HostInfo;
+	uint32_t HostAddress;
+	HostInfo = gethostbyname( address.c_str( ) );
+
+	if( !HostInfo )
+	{
+		m_HasError = true;
+		// m_Error = h_error;
+		LOG_Print( LOGCAT_NETWORK, LOGLEVEL_ERROR, "[TCPCLIENT] error (gethostbyname)" );
+		return;
+	}
+
+	memcpy( &HostAddress, HostInfo->h_addr, HostInfo->h_length );
+
+	// connect
+
+	m_SIN.sin_family = AF_INET;
+	m_SIN.sin_addr.s_addr = HostAddress;
+	m_SIN.sin_port = htons( port );
+
+	if( connect( m_Socket, (struct sockaddr *)&m_SIN, sizeof( m_SIN ) ) == SOCKET_ERROR )
+	{
+		if( GetLastError( ) != EINPROGRESS && GetLastError( ) != EWOULDBLOCK )
+		{
+			// connect error
+
+			m_HasError = true;
+			m_Error = GetLastError( );
+			LOG_Print( LOGCAT_NETWORK, LOGLEVEL_ERROR, "[TCPCLIENT] error (connect) - " + GetErrorString( ) );
+			return;
+		}
+	}
+
+	m_Connecting = true;
+	Poll( );
+}
+
+bool CTCPClient :: CheckConnect( )
+{
+	if( m_Socket == INVALID_SOCKET || m_HasError || !m_Connecting )
+		return false;
+
+	// check if the socket is connected
+
+#ifdef WIN32
+	fd_set fd;
+	FD_ZERO( &fd );
+	FD_SET( m_Socket, &fd );
+
+	struct timeval tv;
+	tv.tv_sec = 0;
+	tv.tv_usec = 0;
+
+	if( select( 1, NULL, &fd, NULL, &tv ) == SOCKET_ERROR )
+	{
+		m_HasError = true;
+		m_Error = GetLastError( );
+		return false;
+	}
+
+	if( FD_ISSET( m_Socket, &fd ) )
+#else
+	// use poll instead of select here since the descriptor may be larger than FD_SETSIZE when using a socket poller
+
+	struct pollfd pfd;
+	pfd.fd = m_Socket;
+	pfd.events = POLLOUT;
+	pfd.revents = 0;
+
+	if( poll( &pfd, 1, 0 ) == SOCKET_ERROR )
+	{
+		m_HasError = true;
+		m_Error = GetLastError( );
+		return false;
+	}
+
+	if( pfd.revents & ( POLLOUT | POLLERR | POLLHUP ) )
+#endif
+	{
+		m_Connecting = false;
+		m_Connected = true;
+		return true;
+	}
+
+	return false;
+}
+
+//
+// CTCPServer
+//
+
+CTCPServer :: CTCPServer( ) : CTCPSocket( )
+{
+	// set the socket to reuse the address in case it hasn't been released yet
+
+	int optval = 1;
+
+#ifdef WIN32
+	setsockopt( m_Socket, SOL_SOCKET, SO_REUSEADDR, (const char *)&optval, sizeof( int ) );
+#else
+	setsockopt( m_Socket, SOL_SOCKET, SO_REUSEADDR, (const void *)&optval, sizeof( int ) );
+#endif
+}
+
+CTCPServer :: ~CTCPServer( )
+{
+
+}
+
+bool CTCPServer :: Listen( string address, uint16_t port )
+{
+	if( m_Socket == INVALID_SOCKET || m_HasError )
+		return false;
+
+	m_SIN.sin_family = AF_INET;
+
+	if( !address.empty( ) )
+	{
+		if( ( m_SIN.sin_addr.s_addr = inet_addr( address.c_str( ) ) ) == INADDR_NONE )
+			m_SIN.sin_addr.s_addr = INADDR_ANY;
+	}
+	else
+		m_SIN.sin_addr.s_addr = INADDR_ANY;
+
+	m_SIN.sin_port = htons( port );
+
+	if( bind( m_Socket, (struct sockaddr *)&m_SIN, sizeof( m_SIN ) ) == SOCKET_ERROR )
+	{
+		m_HasError = true;
+		m_Error = GetLastError( );
+		LOG_Print( LOGCAT_NETWORK, LOGLEVEL_ERROR, "[TCPSERVER] error (bind) - " + GetErrorString( ) );
+		return false;
+	}
+
+	// listen, queue length 8
+
+	if( listen( m_Socket, 8 ) == SOCKET_ERROR )
+	{
+		m_HasError = true;
+		m_Error = GetLastError( );
+		LOG_Print( LOGCAT_NETWORK, LOGLEVEL_ERROR, "[TCPSERVER] error (listen) - " + GetErrorString( ) );
+		return false;
+	}
+
+	Poll( );
+	return true;
+}
+
+CTCPSocket *CTCPServer :: Accept( fd_set *fd )
+{
+	if( m_Socket == INVALID_SOCKET || m_HasError )
+		return NULL;
+
+	if( IsReadable( fd ) )
+	{
+		// a connection is waiting, accept it
+
+		struct sockaddr_in Addr;
+		int AddrLen = sizeof( Addr );
+		SOCKET NewSocket;
+
+#ifdef WIN32
+		if( ( NewSocket = accept( m_Socket, (struct sockaddr *)&Addr, &AddrLen ) ) == INVALID_SOCKET )
+#else
+		if( ( NewSocket = accept( m_Socket, (struct sockaddr *)&Addr, (socklen_t *)&AddrLen ) ) == INVALID_SOCKET )
+#endif
+		{
+			// accept error, ignore it
+		}
+		else
+		{
+			// success! return the new socket
+
+			return new CTCPSocket( NewSocket, Addr );
+		}
+	}
+
+	return NULL;
+}
+
+//
+// CUDPSocket
+//
+
+CUDPSocket :: CUDPSocket( ) : CSocket( )
+{
+	Allocate( SOCK_DGRAM );
+
+	// enable broadcast support
+
+	int OptVal = 1;
+	setsockopt( m_Socket, SOL_SOCKET, SO_BROADCAST, (const char *)&OptVal, sizeof( int ) );
+	
+	// set default broadcast target
+	m_BroadcastTarget.s_addr = INADDR_BROADCAST;
+}
+
+CUDPSocket :: ~CUDPSocket( )
+{
+
+}
+
+bool CUDPSocket :: SendTo( struct sockaddr_in sin, BYTEARRAY message )
+{
+	if( m_Socket == INVALID_SOCKET || m_HasError )
+		return false;
+
+	string MessageString = string( message.begin( ), message.end( ) );
+
+	if( sendto( m_Socket, MessageString.c_str( ), MessageString.size( ), 0, (struct sockaddr *)&sin, sizeof( sin ) ) == -1 )
+		return false;
+
+	return true;
+}
+
+bool CUDPSocket :: SendTo( string address, uint16_t port, BYTEARRAY message )
+{
+	if( m_Socket == INVALID_SOCKET || m_HasError )
+		return false;
+
+	// get IP address
+
+	struct hostent *HostInfo;
+	uint32_t HostAddress;
+	HostInfo = gethostbyname( address.c_str( ) );
+
+	if( !HostInfo )
+	{
+		m_HasError = true;
+		// m_Error = h_error;
+		LOG_Print( LOGCAT_NETWORK, LOGLEVEL_ERROR, "[UDPSOCKET] error (gethostbyname)" );
+		return false;
+	}
+
+	memcpy( &HostAddress, HostInfo->h_addr, HostInfo->h_length );
+	struct sockaddr_in sin;
+	sin.sin_family = AF_INET;
+	sin.sin_addr.s_addr = HostAddress;
+	sin.sin_port = htons( port );
+
+	return SendTo( sin, message );
+}
+
+bool CUDPSocket :: Broadcast( uint16_t port, BYTEARRAY message )
+{
+	if( m_Socket == INVALID_SOCKET || m_HasError )
+		return false;
+
+	struct sockaddr_in sin;
+	sin.sin_family = AF_INET;
+	sin.sin_addr.s_addr = m_BroadcastTarget.s_addr;
+	sin.sin_port = htons( port );
+
+	string MessageString = string( message.begin( ), message.end( ) );
+
+	if( sendto( m_Socket, MessageString.c_str( ), MessageString.size( ), 0, (struct sockaddr *)&sin, sizeof( sin ) ) == -1 )
+	{
+		LOG_Print( LOGCAT_NETWORK, LOGLEVEL_WARNING, "[UDPSOCKET] failed to broadcast packet (port " + UTIL_ToString( port ) + ", size " + UTIL_ToString( MessageString.size( ) ) + " bytes)" );
+		return false;
+	}
+
+	return true;
+}
+
+void CUDPSocket :: SetBroadcastTarget( string subnet )
+{
+	if( subnet.empty( ) )
+	{
+		LOG_Print( LOGCAT_NETWORK, LOGLEVEL_INFO, "[UDPSOCKET] using default broadcast target" );
+		m_BroadcastTarget.s_addr = INADDR_BROADCAST;
+	}
+	else
+	{
+		// this function does not check whether the given subnet is a valid subnet the user is on
+		// convert string representation of ip/subnet to in_addr
+
+		LOG_Print( LOGCAT_NETWORK, LOGLEVEL_INFO, "[UDPSOCKET] using broadcast target [" + subnet + "]" );
+		m_BroadcastTarget.s_addr = inet_addr( subnet.c_str( ) );
+
+		// if conversion fails, inet_addr( ) returns INADDR_NONE
+
+		if( m_BroadcastTarget.s_addr == INADDR_NONE )
+		{
+			LOG_Print( LOGCAT_NETWORK, LOGLEVEL_WARNING, "[UDPSOCKET] invalid broadcast target, using default broadcast target" );
+			m_BroadcastTarget.s_addr = INADDR_BROADCAST;
+		}
+	}
+}
+
+void CUDPSocket :: SetDontRoute( bool dontRoute )
+{
+	int OptVal = 0;
+
+	if( dontRoute )
+		OptVal = 1;
+
+	// don't route packets; make them ignore routes set by routing table and send them to the interface
+	// belonging to the target address directly
+
+	setsockopt( m_Socket, SOL_SOCKET, SO_DONTROUTE, (const char *)&OptVal, sizeof( int ) );
+}
+
+//
+// CUDPServer
+//
+
+CUDPServer :: CUDPServer( ) : CUDPSocket( )
+{
+	// make socket non blocking
+
+#ifdef WIN32
+	int iMode = 1;
+	ioctlsocket( m_Socket, FIONBIO, (u_long FAR *)&iMode );
+#else
+	fcntl( m_Socket, F_SETFL, fcntl( m_Socket, F_GETFL ) | O_NONBLOCK );
+#endif
+
+	// set the socket to reuse the address
+	// with UDP sockets this allows more than one program to listen on the same port
+
+	int optval = 1;
+
+#ifdef WIN32
+	setsockopt( m_Socket, SOL_SOCKET, SO_REUSEADDR, (const char *)&optval, sizeof( int ) );
+#else
+	setsockopt( m_Socket, SOL_SOCKET, SO_REUSEADDR, (const void *)&optval, sizeof( int ) );
+#endif
+}
+
+CUDPServer :: ~CUDPServer( )
+{
+
+}
+
+bool CUDPServer :: Bind( struct sockaddr_in sin )
+{
+	if( m_Socket == INVALID_SOCKET || m_HasError )
+		return false;
+
+	m_SIN = sin;
+
+	if( bind( m_Socket, (struct sockaddr *)&m_SIN, sizeof( m_SIN ) ) == SOCKET_ERROR )
+	{
+		m_HasError = true;
+		m_Error = GetLastError( );
+		LOG_Print( LOGCAT_NETWORK, LOGLEVEL_ERROR, "[UDPSERVER] error (bind) - " + GetErrorString( ) );
+		return false;
+	}
+
+	Poll( );
+	return true;
+}
+
+bool CUDPServer :: Bind( string address, uint16_t port )
+{
+	if( m_Socket == INVALID_SOCKET || m_HasError )
+		return false;
+
+	struct sockaddr_in sin;
+	sin.sin_family = AF_INET;
+
+	if( !address.empty( ) )
+	{
+		if( ( sin.sin_addr.s_addr = inet_addr( address.c_str( ) ) ) == INADDR_NONE )
+			sin.sin_addr.s_addr = INADDR_ANY;
+	}
+	else
+		sin.sin_addr.s_addr = INADDR_ANY;
+
+	sin.sin_port = htons( port );
+
+	return Bind( sin );
+}
+
+void CUDPServer :: RecvFrom( fd_set *fd, struct sockaddr_in *sin, string *message )
+{
+	if( m_Socket == INVALID_SOCKET || m_HasError || !sin || !message )
+		return;
+
+	int AddrLen = sizeof( *sin );
+
+	if( IsReadable( fd ) )
+	{
+		// data is waiting, receive it
+
+		char buffer[1024];
+
+#ifdef WIN32
+		int c = recvfrom( m_Socket, buffer, 1024, 0, (struct sockaddr *)sin, &AddrLen );
+#else
+		int c = recvfrom( m_Socket, buffer, 1024, 0, (struct sockaddr *)sin, (socklen_t *)&AddrLen );
+#endif
+
+		if( c > 0 )
+		{
+			// success!
+
+			*message = string( buffer, c );
+		}
+		else if( c == SOCKET_ERROR && GetLastError( ) != EWOULDBLOCK )
+		{
+			// receive error
+
+			m_HasError = true;
+			m_Error = GetLastError( );
+			LOG_Print( LOGCAT_NETWORK, LOGLEVEL_ERROR, "[UDPSERVER] error (recvfrom) - " + GetErrorString( ) );
+		}
+	}
+}
+
+//
+// CSocketPoller
+//
+
+CSocketPoller :: CSocketPoller( )
+{
+
+}
+
+CSocketPoller :: ~CSocketPoller( )
+{
+	ClearReady( );
+}
+
+void CSocketPoller :: Remove( CSocket *socket )
+{
+	// the socket may be deleted before the next call to Wait so make sure we don't touch it again
+
+	for( vector<CSocket *> :: iterator i = m_Ready.begin( ); i != m_Ready.end( ); )
+	{
+		if( *i == socket )
+			i = m_Ready.erase( i );
+		else
+			i++;
+	}
+
+	socket->SetReadable( false );
+	socket->SetPoller( NULL );
+}
+
+void CSocketPoller :: ClearReady( )
+{
+	for( vector<CSocket *> :: iterator i = m_Ready.begin( ); i != m_Ready.end( ); i++ )
+		(*i)->SetReadable( false );
+
+	m_Ready.clear( );
+}
+
+void CSocketPoller :: SetReady( CSocket *socket )
+{
+	socket->SetReadable( true );
+	m_Ready.push_back( socket );
+}
+
+#ifdef GHOST_EPOLL
+
+//
+// CEPollSocketPoller
+//
+
+CEPollSocketPoller :: CEPollSocketPoller( ) : CSocketPoller( )
+{
+	m_EPoll = epoll_create( 256 );
+
+	if( m_EPoll == -1 )
+		LOG_Print( LOGCAT_NETWORK, LOGLEVEL_ERROR, "[EPOLL] error (epoll_create) - " + UTIL_ToString( GetLastError( ) ) );
+
+	m_Events.resize( 256 );
+}
+
+CEPollSocketPoller :: ~CEPollSocketPoller( )
+{
+	if( m_EPoll != -1 )
+		close( m_EPoll );
+}
+
+bool CEPollSocketPoller :: Add( CSocket *socket )
+{
+	if( m_EPoll == -1 )
+		return false;
+
+	struct epoll_event Event;
+	memset( &Event, 0, sizeof( Event ) );
+	Event.events = EPOLLIN;
+	Event.data.ptr = socket;
+
+	if( epoll_ctl( m_EPoll, EPOLL_CTL_ADD, socket->GetFD( ), &Event ) == -1 )
+	{
+		LOG_Print( LOGCAT_NETWORK, LOGLEVEL_ERROR, "[EPOLL] error (epoll_ctl add) - " + UTIL_ToString( GetLastError( ) ) );
+		return false;
+	}
+
+	socket->SetPoller( this );
+	return true;
+}
+
+void CEPollSocketPoller :: Remove( CSocket *socket )
+{
+	// this must happen before the descriptor is closed
+	// the kernel would drop it from the epoll set on close anyway but only if there are no other references to the descriptor
+
+	if( m_EPoll != -1 && socket->GetFD( ) != INVALID_SOCKET )
+	{
+		struct epoll_event Event;
+		memset( &Event, 0, sizeof( Event ) );
+		epoll_ctl( m_EPoll, EPOLL_CTL_DEL, socket->GetFD( ), &Event );
+	}
+
+	CSocketPoller :: Remove( socket );
+}
+
+int CEPollSocketPoller :: Wait( long usecBlock )
+{
+	ClearReady( );
+
+	if( m_EPoll == -1 )
+	{
+		MILLISLEEP( usecBlock / 1000 );
+		return 0;
+	}
+
+	int NumEvents = epoll_wait( m_EPoll, &m_Events[0], m_Events.size( ), usecBlock / 1000 );
+
+	if( NumEvents == -1 )
+	{
+		if( GetLastError( ) != EINTR )
+			LOG_Print( LOGCAT_NETWORK, LOGLEVEL_ERROR, "[EPOLL] error (epoll_wait) - " + UTIL_ToString( GetLastError( ) ) );
+
+		return 0;
+	}
+
+	// errors and hangups are flagged as readable too so the owner finds out about them the next time it calls recv
+
+	for( int i = 0; i < NumEvents; i++ )
+		SetReady( (CSocket *)m_Events[i].data.ptr );
+
+	// if we filled the event buffer there are probably more events waiting, grow it for next time
+
+	if( (unsigned int)NumEvents == m_Events.size( ) )
+		m_Events.resize( m_Events.size( ) * 2 );
+
+	return NumEvents;
+}
+
+#endif
+
+#ifdef GHOST_TIMERFD
+
+//
+// CActionTimer
+//
+
+CActionTimer :: CActionTimer( ) : CSocket( )
+{
+	m_Socket = timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK );
+
+	if( m_Socket == INVALID_SOCKET )
+	{
+		m_HasError = true;
+		m_Error = GetLastError( );
+		LOG_Print( LOGCAT_NETWORK, LOGLEVEL_ERROR, "[ACTIONTIMER] error (timerfd_create) - " + GetErrorString( ) );
+		return;
+	}
+
+	Poll( );
+}
+
+CActionTimer :: ~CActionTimer( )
+{
+
+}
+
+void CActionTimer :: Arm( uint32_t ticks )
+{
+	if( m_Socket == INVALID_SOCKET )
+		return;
+
+	// GetTicks is CLOCK_MONOTONIC truncated to milliseconds so the timer is set to the start of the millisecond GetTicks reaches ticks
+	// a zero expiration time disarms the timer so if that millisecond has already started we use the smallest possible expiration time instead
+
+	struct timespec Now;
+	clock_gettime( CLOCK_MONOTONIC, &Now );
+	uint64_t NowTicks = (uint64_t)Now.tv_sec * 1000 + Now.tv_nsec / 1000000;
+	int32_t Delay = (int32_t)( ticks - (uint32_t)NowTicks );
+	struct itimerspec Timer;
+	memset( &Timer, 0, sizeof( Timer ) );
+
+	if( Delay > 0 )
+	{
+		uint64_t Expiration = NowTicks + Delay;
+		Timer.it_value.tv_sec = Expiration / 1000;
+		Timer.it_value.tv_nsec = ( Expiration % 1000 ) * 1000000;
+	}
+	else
+		Timer.it_value.tv_nsec = 1;
+
+	if( timerfd_settime( m_Socket, TFD_TIMER_ABSTIME, &Timer, NULL ) == -1 )
+	{
+		m_HasError = true;
+		m_Error = GetLastError( );
+		LOG_Print( LOGCAT_NETWORK, LOGLEVEL_ERROR, "[ACTIONTIMER] error (timerfd_settime) - " + GetErrorString( ) );
+	}
+}
+
+void CActionTimer :: Disarm( )
+{
+	if( m_Socket == INVALID_SOCKET )
+		return;
+
+	struct itimerspec Timer;
+	memset( &Timer, 0, sizeof( Timer ) );
+	timerfd_settime( m_Socket, 0, &Timer, NULL );
+}
+
+bool CActionTimer :: Check( fd_set *fd )
+{
+	if( !IsReadable( fd ) )
+		return false;
+
+	// reading the number of expirations resets the timer's readable state
+
+	uint64_t Expirations = 0;
+	return read( m_Socket, &Expirations, sizeof( Expirations ) ) == sizeof( Expirations ) && Expirations > 0;
+}
+
+#endif
@@ -1,231 +1,380 @@
-/*
-
-   Copyright [2008] [Trevor Hogan]
-
-   Licensed under the Apache License, Version 2.0 (the "License");
-   you may not use this file except in compliance with the License.
-   You may obtain a copy of the License at
-
-       http://www.apache.org/licenses/LICENSE-2.0
-
-   Unless required by applicable law or agreed to in writing, software
-   distributed under the License is distributed on an "AS IS" BASIS,
-   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-   See the License for the specific language governing permissions and
-   limitations under the License.
-
-   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
-
-*/
-
-#ifndef SOCKET_H
-#define SOCKET_H
-
-#ifdef WIN32
- #include <winsock2.h>
- #include <errno.h>
-
- #define EADDRINUSE WSAEADDRINUSE
- #define EADDRNOTAVAIL WSAEADDRNOTAVAIL
- #define EAFNOSUPPORT WSAEAFNOSUPPORT
- #define EALREADY WSAEALREADY
- #define ECONNABORTED WSAECONNABORTED
- #define ECONNREFUSED WSAECONNREFUSED
- #define ECONNRESET WSAECONNRESET
- #define EDESTADDRREQ WSAEDESTADDRREQ
- #define EDQUOT WSAEDQUOT
- #define EHOSTDOWN WSAEHOSTDOWN
- #define EHOSTUNREACH WSAEHOSTUNREACH
- #define EINPROGRESS WSAEINPROGRESS
- #define EISCONN WSAEISCONN
- #define ELOOP WSAELOOP
- #define EMSGSIZE WSAEMSGSIZE
- // #define ENAMETOOLONG WSAENAMETOOLONG
- #define ENETDOWN WSAENETDOWN
- #define ENETRESET WSAENETRESET
- #define ENETUNREACH WSAENETUNREACH
- #define ENOBUFS WSAENOBUFS
- #define ENOPROTOOPT WSAENOPROTOOPT
- #define ENOTCONN WSAENOTCONN
- // #define ENOTEMPTY WSAENOTEMPTY
- #define ENOTSOCK WSAENOTSOCK
- #define EOPNOTSUPP WSAEOPNOTSUPP
- #define EPFNOSUPPORT WSAEPFNOSUPPORT
- #define EPROTONOSUPPORT WSAEPROTONOSUPPORT
- #define EPROTOTYPE WSAEPROTOTYPE
- #define EREMOTE WSAEREMOTE
- #define ESHUTDOWN WSAESHUTDOWN
- #define ESOCKTNOSUPPORT WSAESOCKTNOSUPPORT
- #define ESTALE WSAESTALE
- #define ETIMEDOUT WSAETIMEDOUT
- #define ETOOMANYREFS WSAETOOMANYREFS
- #define EUSERS WSAEUSERS
- #define EWOULDBLOCK WSAEWOULDBLOCK
-#else
- #include <arpa/inet.h>
- #include <errno.h>
- #include <fcntl.h>
- #include <netdb.h>
- #include <netinet/in.h>
- #include <netinet/tcp.h>
- #include <sys/ioctl.h>
- #include <sys/socket.h>
- #include <sys/types.h>
- #include <unistd.h>
-
- typedef int SOCKET;
-
- #define INVALID_SOCKET -1
- #define SOCKET_ERROR -1
-
- #define closesocket close
-
- extern int GetLastError( );
-#endif
-
-#ifndef INADDR_NONE
- #define INADDR_NONE -1
-#endif
-
-#ifndef MSG_NOSIGNAL
- #define MSG_NOSIGNAL 0
-#endif
-
-#ifdef WIN32
- #define SHUT_RDWR 2
-#endif
-
-//
-// CSocket
-//
-
-class CSocket
-{
-protected:
-	SOCKET m_Socket;
-	struct sockaddr_in m_SIN;
-	bool m_HasError;
-	int m_Error;
-
-public:
-	CSocket( );
-	CSocket( SOCKET nSocket, struct sockaddr_in nSIN );
-	~CSocket( );
-
-	virtual BYTEARRAY GetPort( );
-	virtual BYTEARRAY GetIP( );
-	virtual string GetIPString( );
-	virtual bool HasError( )						{ return m_HasError; }
-	virtual int GetError( )							{ return m_Error; }
-	virtual string GetErrorString( );
-	virtual void SetFD( fd_set *fd, fd_set *send_fd, int *nfds );
-	virtual void Allocate( int type );
-	virtual void Reset( );
-};
-
-//
-// CTCPSocket
-//
-
-class CTCPSocket : public CSocket
-{
-protected:
-	bool m_Connected;
-	string m_LogFile;
-
-private:
-	string m_RecvBuffer;
-	string m_SendBuffer;
-	uint32_t m_LastRecv;
-	uint32_t m_LastSend;
-
-public:
-	CTCPSocket( );
-	CTCPSocket( SOCKET nSocket, struct sockaddr_in nSIN );
-	virtual ~CTCPSocket( );
-
-	virtual void Reset( );
-	virtual bool GetConnected( )				{ return m_Connected; }
-	virtual string *GetBytes( )					{ return &m_RecvBuffer; }
-	virtual void PutBytes( string bytes );
-	virtual void PutBytes( BYTEARRAY bytes );
-	virtual void ClearRecvBuffer( )				{ m_RecvBuffer.clear( ); }
-	virtual void ClearSendBuffer( )				{ m_SendBuffer.clear( ); }
-	virtual uint32_t GetLastRecv( )				{ return m_LastRecv; }
-	virtual uint32_t GetLastSend( )				{ return m_LastSend; }
-	virtual void DoRecv( fd_set *fd );
-	virtual void DoSend( fd_set *send_fd );
-	virtual void Disconnect( );
-	virtual void SetNoDelay( bool noDelay );
-	virtual void SetLogFile( string nLogFile )	{ m_LogFile = nLogFile; }
-};
-
-//
-// CTCPClient
-//
-
-class CTCPClient : public CTCPSocket
-{
-protected:
-	bool m_Connecting;
-
-public:
-	CTCPClient( );
-	virtual ~CTCPClient( );
-
-	virtual void Reset( );
-	virtual void Disconnect( );
-	virtual bool GetConnecting( )												{ return m_Connecting; }
-	virtual void Connect( string localaddress, string address, uint16_t port );
-	virtual bool CheckConnect( );
-};
-
-//
-// CTCPServer
-//
-
-class CTCPServer : public CTCPSocket
-{
-public:
-	CTCPServer( );
-	virtual ~CTCPServer( );
-
-	virtual bool Listen( string address, uint16_t port );
-	virtual CTCPSocket *Accept( fd_set *fd );
-};
-
-//
-// CUDPSocket
-//
-
-class CUDPSocket : public CSocket
-{
-protected:
-	struct in_addr m_BroadcastTarget;
-public:
-	CUDPSocket( );
-	virtual ~CUDPSocket( );
-
-	virtual bool SendTo( struct sockaddr_in sin, BYTEARRAY message );
-	virtual bool SendTo( string address, uint16_t port, BYTEARRAY message );
-	virtual bool Broadcast( uint16_t port, BYTEARRAY message );
-	virtual void SetBroadcastTarget( string subnet );
-	virtual void SetDontRoute( bool dontRoute );
-};
-
-//
-// CUDPServer
-//
-
-class CUDPServer : public CUDPSocket
-{
-public:
-	CUDPServer( );
-	virtual ~CUDPServer( );
-
-	virtual bool Bind( struct sockaddr_in sin );
-	virtual bool Bind( string address, uint16_t port );
-	virtual void RecvFrom( fd_set *fd, struct sockaddr_in *sin, string *message );
-};
-
-#endif
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#ifndef SOCKET_H
+#define SOCKET_H
+
+#ifdef WIN32
+ #include <winsock2.h>
+ #include <errno.h>
+
+ #define EADDRINUSE WSAEADDRINUSE
+ #define EADDRNOTAVAIL WSAEADDRNOTAVAIL
+ #define EAFNOSUPPORT WSAEAFNOSUPPORT
+ #define EALREADY WSAEALREADY
+ #define ECONNABORTED WSAECONNABORTED
+ #define ECONNREFUSED WSAECONNREFUSED
+ #define ECONNRESET WSAECONNRESET
+ #define EDESTADDRREQ WSAEDESTADDRREQ
+ #define EDQUOT WSAEDQUOT
+ #define EHOSTDOWN WSAEHOSTDOWN
+ #define EHOSTUNREACH WSAEHOSTUNREACH
+ #define EINPROGRESS WSAEINPROGRESS
+ #define EISCONN WSAEISCONN
+ #define ELOOP WSAELOOP
+ #define EMSGSIZE WSAEMSGSIZE
+ // #define ENAMETOOLONG WSAENAMETOOLONG
+ #define ENETDOWN WSAENETDOWN
+ #define ENETRESET WSAENETRESET
+ #define ENETUNREACH WSAENETUNREACH
+ #define ENOBUFS WSAENOBUFS
+ #define ENOPROTOOPT WSAENOPROTOOPT
+ #define ENOTCONN WSAENOTCONN
+ // #define ENOTEMPTY WSAENOTEMPTY
+ #define ENOTSOCK WSAENOTSOCK
+ #define EOPNOTSUPP WSAEOPNOTSUPP
+ #define EPFNOSUPPORT WSAEPFNOSUPPORT
+ #define EPROTONOSUPPORT WSAEPROTONOSUPPORT
+ #define EPROTOTYPE WSAEPROTOTYPE
+ #define EREMOTE WSAEREMOTE
+ #define ESHUTDOWN WSAESHUTDOWN
+ #define ESOCKTNOSUPPORT WSAESOCKTNOSUPPORT
+ #define ESTALE WSAESTALE
+ #define ETIMEDOUT WSAETIMEDOUT
+ #define ETOOMANYREFS WSAETOOMANYREFS
+ #define EUSERS WSAEUSERS
+ #define EWOULDBLOCK WSAEWOULDBLOCK
+#else
+ #include <arpa/inet.h>
+ #include <errno.h>
+ #include <fcntl.h>
+ #include <netdb.h>
+ #include <netinet/in.h>
+ #include <netinet/tcp.h>
+ #include <poll.h>
+ #include <sys/ioctl.h>
+ #include <sys/socket.h>
+ #include <sys/types.h>
+ #include <sys/uio.h>
+ #include <unistd.h>
+
+ #ifdef __linux__
+  #include <sys/epoll.h>
+  #include <sys/timerfd.h>
+ #endif
+
+ typedef int SOCKET;
+
+ #define INVALID_SOCKET -1
+ #define SOCKET_ERROR -1
+
+ #define closesocket close
+
+ extern int GetLastError( );
+#endif
+
+#ifndef INADDR_NONE
+ #define INADDR_NONE -1
+#endif
+
+#ifndef MSG_NOSIGNAL
+ #define MSG_NOSIGNAL 0
+#endif
+
+#ifdef WIN32
+ #define SHUT_RDWR 2
+#endif
+
+// epoll is only available on Linux, everything else uses the select based update loop in CGHost :: Update
+// the same goes for timerfd which is used for the action timer
+
+#if !defined( WIN32 ) && defined( __linux__ )
+ #define GHOST_EPOLL
+ #define GHOST_TIMERFD
+#endif
+
+class CSocketPoller;
+
+// the socket poller in use, if any
+// when this is NULL sockets aren't registered anywhere and readiness is checked with the fd_set's passed to DoRecv/DoSend/Accept/RecvFrom
+
+extern CSocketPoller *gSocketPoller;
+
+// a thread which waits on its own sockets (e.g. a game thread) sets its own socket poller, sockets polled on that thread register with it instead
+// GetSocketPoller returns the calling thread's socket poller or gSocketPoller if the thread doesn't have one
+
+CSocketPoller *GetSocketPoller( );
+void SetThreadSocketPoller( CSocketPoller *poller );
+
+//
+// CRingBuffer
+//
+
+// a growable ring buffer used for the TCP send and receive buffers
+// data is appended at the write cursor and consumed from the read cursor so removing data from the front never moves the remaining bytes
+// the stored data can wrap around the end of the allocation, in which case it's split into two regions for scatter-gather I/O
+
+class CRingBuffer
+{
+private:
+	unsigned char *m_Buffer;
+	uint32_t m_Capacity;			// always a power of two
+	uint32_t m_Start;				// read cursor
+	uint32_t m_Size;				// number of bytes between the read cursor and the write cursor
+
+	CRingBuffer( const CRingBuffer & );
+	CRingBuffer &operator=( const CRingBuffer & );
+
+public:
+	CRingBuffer( uint32_t nCapacity = 1024 );
+	~CRingBuffer( );
+
+	uint32_t GetSize( )				{ return m_Size; }
+	uint32_t GetCapacity( )			{ return m_Capacity; }
+	uint32_t GetFree( )				{ return m_Capacity - m_Size; }
+	bool GetEmpty( )				{ return m_Size == 0; }
+
+	void Clear( );
+	void Reserve( uint32_t length );
+	void Append( const unsigned char *data, uint32_t length );
+	void Append( const string &data )		{ Append( (const unsigned char *)data.data( ), data.size( ) ); }
+	void Append( const BYTEARRAY &data )	{ if( !data.empty( ) ) Append( &data[0], data.size( ) ); }
+	void Consume( uint32_t length );
+	void Commit( uint32_t length );
+	uint32_t GetReadRegions( unsigned char **data, uint32_t *length );
+	uint32_t GetWriteRegions( unsigned char **data, uint32_t *length );
+	BYTEARRAY GetBytes( uint32_t length );
+	unsigned char *GetData( );
+};
+
+//
+// CSocket
+//
+
+class CSocket
+{
+protected:
+	SOCKET m_Socket;
+	struct sockaddr_in m_SIN;
+	bool m_HasError;
+	int m_Error;
+	CSocketPoller *m_Poller;	// the socket poller we're registered with, if any
+	bool m_Readable;			// set by the socket poller when data is waiting
+
+public:
+	CSocket( );
+	CSocket( SOCKET nSocket, struct sockaddr_in nSIN );
+	~CSocket( );
+
+	virtual BYTEARRAY GetPort( );
+	virtual BYTEARRAY GetIP( );
+	virtual string GetIPString( );
+	virtual bool HasError( )						{ return m_HasError; }
+	virtual int GetError( )							{ return m_Error; }
+	virtual string GetErrorString( );
+	virtual SOCKET GetFD( )							{ return m_Socket; }
+	virtual CSocketPoller *GetPoller( )				{ return m_Poller; }
+	virtual void SetPoller( CSocketPoller *nPoller )	{ m_Poller = nPoller; }
+	virtual void SetReadable( bool nReadable )		{ m_Readable = nReadable; }
+	virtual bool IsReadable( fd_set *fd );
+	virtual bool IsWritable( fd_set *send_fd );
+	virtual void SetFD( fd_set *fd, fd_set *send_fd, int *nfds );
+	virtual void Allocate( int type );
+	virtual void Poll( );
+	virtual void Unpoll( );
+	virtual void Reset( );
+};
+
+//
+// CTCPSocket
+//
+
+class CTCPSocket : public CSocket
+{
+protected:
+	bool m_Connected;
+	string m_LogFile;
+
+private:
+	CRingBuffer m_RecvBuffer;
+	CRingBuffer m_SendBuffer;
+	uint32_t m_LastRecv;
+	uint32_t m_LastSend;
+
+public:
+	CTCPSocket( );
+	CTCPSocket( SOCKET nSocket, struct sockaddr_in nSIN );
+	virtual ~CTCPSocket( );
+
+	virtual void Reset( );
+	virtual bool GetConnected( )				{ return m_Connected; }
+	virtual CRingBuffer *GetBytes( )			{ return &m_RecvBuffer; }
+	virtual void PutBytes( const string &bytes );
+	virtual void PutBytes( const BYTEARRAY &bytes );
+	virtual void ClearRecvBuffer( )				{ m_RecvBuffer.Clear( ); }
+	virtual void ClearSendBuffer( )				{ m_SendBuffer.Clear( ); }
+	virtual uint32_t GetSendBufferSize( )		{ return m_SendBuffer.GetSize( ); }
+	virtual uint32_t GetLastRecv( )				{ return m_LastRecv; }
+	virtual uint32_t GetLastSend( )				{ return m_LastSend; }
+	virtual void DoRecv( fd_set *fd );
+	virtual void DoSend( fd_set *send_fd );
+	virtual void Disconnect( );
+	virtual void SetNoDelay( bool noDelay );
+	virtual void SetLogFile( string nLogFile )	{ m_LogFile = nLogFile; }
+};
+
+//
+// CTCPClient
+//
+
+class CTCPClient : public CTCPSocket
+{
+protected:
+	bool m_Connecting;
+
+public:
+	CTCPClient( );
+	virtual ~CTCPClient( );
+
+	virtual void Reset( );
+	virtual void Disconnect( );
+	virtual bool GetConnecting( )												{ return m_Connecting; }
+	virtual void Connect( string localaddress, string address, uint16_t port );
+	virtual bool CheckConnect( );
+};
+
+//
+// CTCPServer
+//
+
+class CTCPServer : public CTCPSocket
+{
+public:
+	CTCPServer( );
+	virtual ~CTCPServer( );
+
+	virtual bool Listen( string address, uint16_t port );
+	virtual CTCPSocket *Accept( fd_set *fd );
+};
+
+//
+// CUDPSocket
+//
+
+class CUDPSocket : public CSocket
+{
+protected:
+	struct in_addr m_BroadcastTarget;
+public:
+	CUDPSocket( );
+	virtual ~CUDPSocket( );
+
+	virtual bool SendTo( struct sockaddr_in sin, BYTEARRAY message );
+	virtual bool SendTo( string address, uint16_t port, BYTEARRAY message );
+	virtual bool Broadcast( uint16_t port, BYTEARRAY message );
+	virtual void SetBroadcastTarget( string subnet );
+	virtual void SetDontRoute( bool dontRoute );
+};
+
+//
+// CUDPServer
+//
+
+class CUDPServer : public CUDPSocket
+{
+public:
+	CUDPServer( );
+	virtual ~CUDPServer( );
+
+	virtual bool Bind( struct sockaddr_in sin );
+	virtual bool Bind( string address, uint16_t port );
+	virtual void RecvFrom( fd_set *fd, struct sockaddr_in *sin, string *message );
+};
+
+//
+// CSocketPoller
+//
+
+class CSocketPoller
+{
+protected:
+	vector<CSocket *> m_Ready;			// sockets flagged as readable by the last call to Wait
+
+public:
+	CSocketPoller( );
+	virtual ~CSocketPoller( );
+
+	virtual bool GetValid( )					{ return true; }
+	virtual bool Add( CSocket *socket ) = 0;
+	virtual void Remove( CSocket *socket );
+	virtual int Wait( long usecBlock ) = 0;
+
+protected:
+	virtual void ClearReady( );
+	virtual void SetReady( CSocket *socket );
+};
+
+#ifdef GHOST_EPOLL
+
+//
+// CEPollSocketPoller
+//
+
+class CEPollSocketPoller : public CSocketPoller
+{
+private:
+	int m_EPoll;
+	vector<struct epoll_event> m_Events;
+
+public:
+	CEPollSocketPoller( );
+	virtual ~CEPollSocketPoller( );
+
+	virtual bool GetValid( )					{ return m_EPoll != -1; }
+	virtual bool Add( CSocket *socket );
+	virtual void Remove( CSocket *socket );
+	virtual int Wait( long usecBlock );
+};
+
+#endif
+
+#ifdef GHOST_TIMERFD
+
+//
+// CActionTimer
+//
+
+// a timerfd which becomes readable at the exact millisecond the next action packet is due
+// it's waited on along with the sockets so CGHost :: Update wakes up on time rather than when its wait (rounded down to whole milliseconds) runs out
+
+class CActionTimer : public CSocket
+{
+public:
+	CActionTimer( );
+	virtual ~CActionTimer( );
+
+	virtual void Arm( uint32_t ticks );		// fire when GetTicks reaches ticks, firing immediately if it already has
+	virtual void Disarm( );
+	virtual bool Check( fd_set *fd );		// returns true if the timer fired since the last call
+};
+
+#endif
+
+#endif
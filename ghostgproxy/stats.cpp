@@ -1,51 +1,223 @@
-/*
-
-   Copyright [2008] [Trevor Hogan]
-
-   Licensed under the Apache License, Version 2.0 (the "License");
-   you may not use this file except in compliance with the License.
-   You may obtain a copy of the License at
-
-       http://www.apache.org/licenses/LICENSE-2.0
-
-   Unless required by applicable law or agreed to in writing, software
-   distributed under the License is distributed on an "AS IS" BASIS,
-   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-   See the License for the specific language governing permissions and
-   limitations under the License.
-
-   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
-
-*/
-
-#include "ghost.h"
-#include "stats.h"
-
-//
-// CStats
-//
-
-CStats :: CStats( CBaseGame *nGame )
-{
-	m_Game = nGame;
-}
-
-CStats :: ~CStats( )
-{
-
-}
-
-bool CStats :: ProcessAction( CIncomingAction *Action, CGHostDB *DB, CGHost *GHost )
-{
-	return false;
-}
-
-void CStats :: Save( CGHost *GHost, vector<CDBGamePlayer *>& DBGamePlayers, CGHostDB *DB, uint32_t GameID )
-{
-
-}
-
-void CStats :: SetWinner(uint32_t winner)
-{
-	
-}
\ No newline at end of file
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#include "ghost.h"
+#include "stats.h"
+
+#include <string.h>
+
+//
+// CStatsGame
+//
+
+CStatsGame :: CStatsGame( )
+{
+
+}
+
+CStatsGame :: ~CStatsGame( )
+{
+
+}
+
+//
+// CStats
+//
+
+CStats :: CStats( CStatsGame *nGame )
+{
+	m_Game = nGame;
+}
+
+CStats :: ~CStats( )
+{
+
+}
+
+bool CStats :: ProcessAction( CIncomingAction *Action, CGHostDB *DB, CGHost *GHost )
+{
+	return false;
+}
+
+void CStats :: Save( CGHost *GHost, vector<CDBGamePlayer *>& DBGamePlayers, CGHostDB *DB, uint32_t GameID )
+{
+
+}
+
+void CStats :: SetWinner(uint32_t winner)
+{
+	
+}
+
+uint32_t CStats :: GetActionLength( const unsigned char *data, uint32_t size )
+{
+	// returns the length of the action at the start of data including the action id
+	// returns zero if we don't know the action or if it's truncated
+	// the lengths are for patch 1.14b and newer, note that w3g_actions.txt lists the pre 1.13 lengths for actions 0x11 to 0x14
+
+	const unsigned char *End = data + size;
+	const unsigned char *String;
+	uint32_t Length = 0;
+
+	switch( data[0] )
+	{
+	case 0x01: case 0x02: case 0x04: case 0x05: case 0x1A: case 0x61: case 0x66: case 0x67:
+	case 0x20: case 0x22: case 0x23: case 0x24: case 0x25: case 0x26: case 0x29: case 0x2A:
+	case 0x2B: case 0x2C: case 0x2F: case 0x30: case 0x31: case 0x32:
+		Length = 1;
+		break;
+	case 0x03: case 0x75:
+		Length = 2;
+		break;
+	case 0x18:
+		Length = 3;
+		break;
+	case 0x07: case 0x2E:
+		Length = 5;
+		break;
+	case 0x1E: case 0x27: case 0x28: case 0x2D: case 0x50:
+		Length = 6;
+		break;
+	case 0x1D: case 0x21:
+		Length = 9;
+		break;
+	case 0x1B: case 0x1C: case 0x51:
+		Length = 10;
+		break;
+	case 0x19: case 0x62: case 0x68:
+		Length = 13;
+		break;
+	case 0x10:
+		Length = 15;
+		break;
+	case 0x69: case 0x6A:
+		Length = 17;
+		break;
+	case 0x11:
+		Length = 23;
+		break;
+	case 0x12:
+		Length = 31;
+		break;
+	case 0x13:
+		Length = 39;
+		break;
+	case 0x14:
+		Length = 44;
+		break;
+	case 0x16: case 0x17:
+		// change selection and assign group hotkey have a list of object ids
+
+		if( size >= 4 )
+			Length = 4 + ( data[2] | ( data[3] << 8 ) ) * 8;
+
+		break;
+	case 0x06:
+		// save game has a null terminated string
+
+		if( ( String = (const unsigned char *)memchr( data + 1, 0, size - 1 ) ) )
+			Length = String - data + 1;
+
+		break;
+	case 0x60:
+		// map trigger chat command has two dwords and a null terminated string
+
+		if( size > 9 && ( String = (const unsigned char *)memchr( data + 9, 0, size - 9 ) ) )
+			Length = String - data + 1;
+
+		break;
+	case 0x6B:
+		// sync stored integer has three null terminated strings and a dword
+
+		String = data;
+
+		for( unsigned int i = 0; i < 3 && String; i++ )
+		{
+			if( ++String < End )
+				String = (const unsigned char *)memchr( String, 0, End - String );
+			else
+				String = NULL;
+		}
+
+		if( String )
+			Length = String - data + 5;
+
+		break;
+	}
+
+	if( Length > size )
+		return 0;
+
+	return Length;
+}
+
+bool CStats :: NextStoredInteger( const BYTEARRAY &action, uint32_t &position, const string &file, const char *&missionKey, uint32_t &missionKeyLength, const char *&key, uint32_t &keyLength, const unsigned char *&value )
+{
+	if( action.empty( ) )
+		return false;
+
+	const unsigned char *Data = &action[0];
+	const unsigned char *End = Data + action.size( );
+	uint32_t FileSize = file.size( ) + 1;
+
+	while( position < action.size( ) )
+	{
+		const unsigned char *Action = Data + position;
+		uint32_t Length = GetActionLength( Action, End - Action );
+
+		if( Length == 0 )
+		{
+			// we can't tell where the next action starts so search for the next 0x6b marker followed by the file name
+			// this isn't guaranteed to find an action but it's the best we can do
+
+			position = action.size( );
+
+			for( const unsigned char *Next = Action + 1; Next < End; Next++ )
+			{
+				if( !( Next = (const unsigned char *)memchr( Next, 0x6b, End - Next ) ) )
+					break;
+
+				if( (uint32_t)( End - Next ) > FileSize && memcmp( Next + 1, file.c_str( ), FileSize ) == 0 )
+				{
+					position = Next - Data;
+					break;
+				}
+			}
+
+			continue;
+		}
+
+		position += Length;
+
+		if( Action[0] == 0x6b && Length > FileSize + 1 && memcmp( Action + 1, file.c_str( ), FileSize ) == 0 )
+		{
+			// GetActionLength already checked the null terminators are there
+
+			missionKey = (const char *)Action + 1 + FileSize;
+			missionKeyLength = strlen( missionKey );
+			key = missionKey + missionKeyLength + 1;
+			keyLength = strlen( key );
+			value = (const unsigned char *)key + keyLength + 1;
+			return true;
+		}
+	}
+
+	return false;
+}
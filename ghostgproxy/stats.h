@@ -1,54 +1,88 @@
-/*
-
-   Copyright [2008] [Trevor Hogan]
-
-   Licensed under the Apache License, Version 2.0 (the "License");
-   you may not use this file except in compliance with the License.
-   You may obtain a copy of the License at
-
-       http://www.apache.org/licenses/LICENSE-2.0
-
-   Unless required by applicable law or agreed to in writing, software
-   distributed under the License is distributed on an "AS IS" BASIS,
-   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-   See the License for the specific language governing permissions and
-   limitations under the License.
-
-   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
-
-*/
-
-#ifndef STATS_H
-#define STATS_H
-
-//
-// CStats
-//
-
-// the stats class is passed a copy of every player action in ProcessAction when it's received
-// then when the game is over the Save function is called
-// so the idea is that you parse the actions to gather data about the game, storing the results in any member variables you need in your subclass
-// and in the Save function you write the results to the database
-// e.g. for dota the number of kills/deaths/assists, etc...
-// the base class is almost completely empty
-
-class CIncomingAction;
-class CGHostDB;
-class CDBGamePlayer;
-class CDBDotAPlayer;
-
-class CStats
-{
-protected:
-	CBaseGame *m_Game;
-
-public:
-	CStats( CBaseGame *nGame );
-	virtual ~CStats( );
-	virtual void SetWinner(uint32_t winner);
-
-	virtual bool ProcessAction( CIncomingAction *Action, CGHostDB *DB, CGHost *GHost );
-	virtual void Save( CGHost *GHost, vector<CDBGamePlayer *>& DBGamePlayers, CGHostDB *DB, uint32_t GameID );
-};
-
-#endif
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#ifndef STATS_H
+#define STATS_H
+
+//
+// CStats
+//
+
+// the stats class is passed a copy of every player action in ProcessAction when it's received
+// then when the game is over the Save function is called
+// so the idea is that you parse the actions to gather data about the game, storing the results in any member variables you need in your subclass
+// and in the Save function you write the results to the database
+// e.g. for dota the number of kills/deaths/assists, etc...
+// the base class is almost completely empty
+
+class CIncomingAction;
+class CGHostDB;
+class CDBGamePlayer;
+class CDBDotAPlayer;
+class CBaseCallable;
+
+//
+// CStatsGame
+//
+
+// the stats classes only see the game through this interface
+// it's implemented by CBaseGame for live games and by the replay analyzer (see analyze_replays) for replays
+
+class CStatsGame
+{
+public:
+	CStatsGame( );
+	virtual ~CStatsGame( );
+
+	virtual string GetGameName( ) = 0;
+	virtual uint32_t GetStatsTime( ) = 0;										// the current game time in seconds
+	virtual string GetStatsPlayerName( uint32_t colour ) = 0;					// returns an empty string if there's no player with this colour
+	virtual void SetStatsPlayerTeam( uint32_t colour, uint32_t team ) = 0;
+	virtual void EventStatsGameStart( ) = 0;									// the map reported that the game has started
+	virtual void AddStatsCallable( CBaseCallable *callable ) = 0;				// the database callables created by the stats class
+};
+
+//
+// CStats
+//
+
+class CStats
+{
+protected:
+	CStatsGame *m_Game;
+
+	// maps send their data to the host with sync stored integer actions (0x6b) made up of three null terminated strings and a 4 byte integer
+	// NextStoredInteger walks an action block by type and length (see w3g_actions.txt) and returns the next one written to the given file
+	// if it finds an action it doesn't know the length of it falls back to searching for the next 0x6b marker
+	// the mission key and key point into the action data so they're only valid as long as the action is
+
+	static uint32_t GetActionLength( const unsigned char *data, uint32_t size );
+	static bool NextStoredInteger( const BYTEARRAY &action, uint32_t &position, const string &file, const char *&missionKey, uint32_t &missionKeyLength, const char *&key, uint32_t &keyLength, const unsigned char *&value );
+
+public:
+	CStats( CStatsGame *nGame );
+	virtual ~CStats( );
+	virtual void SetWinner(uint32_t winner);
+
+	virtual bool ProcessAction( CIncomingAction *Action, CGHostDB *DB, CGHost *GHost );
+	virtual void Save( CGHost *GHost, vector<CDBGamePlayer *>& DBGamePlayers, CGHostDB *DB, uint32_t GameID );
+};
+
+#endif
@@ -1,51 +1,106 @@
-/*
-
-   Copyright [2008] [Trevor Hogan]
-
-   Licensed under the Apache License, Version 2.0 (the "License");
-   you may not use this file except in compliance with the License.
-   You may obtain a copy of the License at
-
-       http://www.apache.org/licenses/LICENSE-2.0
-
-   Unless required by applicable law or agreed to in writing, software
-   distributed under the License is distributed on an "AS IS" BASIS,
-   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-   See the License for the specific language governing permissions and
-   limitations under the License.
-
-   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
-
-*/
-
-#ifndef STATSDOTA_H
-#define STATSDOTA_H
-
-//
-// CStatsDOTA
-//
-
-class CDBDotAPlayer;
-class CDBGamePlayer;
-
-class CStatsDOTA : public CStats
-{
-private:
-	CDBDotAPlayer *m_Players[12];
-	uint32_t m_Winner;
-	uint32_t m_Min;
-	uint32_t m_Sec;
-	uint32_t m_GameStart;
-
-public:
-	CStatsDOTA( CBaseGame *nGame );
-	virtual ~CStatsDOTA( );
-	
-	virtual void SetWinner(uint32_t winner) { m_Winner = winner; }
-
-	virtual bool ProcessAction( CIncomingAction *Action, CGHostDB *DB, CGHost *GHost );
-	virtual void Save( CGHost *GHost, vector<CDBGamePlayer *>& DBGamePlayers, CGHostDB *DB, uint32_t GameID );
-	
-};
-
-#endif
+/*
+
+   Copyright [2008] [Trevor Hogan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   CODE PORTED FROM THE ORIGINAL GHOST PROJECT: http://ghost.pwner.org/
+
+*/
+
+#ifndef STATSDOTA_H
+#define STATSDOTA_H
+
+//
+// CStatsDOTA
+//
+
+class CDBDotAPlayer;
+class CDBGamePlayer;
+
+class CStatsDOTA : public CStats
+{
+public:
+	// the keys DotA sends us, each key is looked up once per action and then dispatched with a switch
+
+	enum DotAKey {
+		KEY_UNKNOWN,
+
+		// "Data" keys, most of these have the player colour appended
+
+		KEY_HERO,
+		KEY_LEVEL,
+		KEY_ASSIST,
+		KEY_COURIER,
+		KEY_TOWER,
+		KEY_RAX,
+		KEY_THRONE,
+		KEY_TREE,
+		KEY_CK,
+		KEY_CSK,
+		KEY_CSD,
+		KEY_NK,
+		KEY_GAMESTART,
+
+		// "Global" keys
+
+		KEY_WINNER,
+		KEY_MIN,
+		KEY_SEC,
+
+		// player keys
+
+		KEY_KILLS,
+		KEY_DEATHS,
+		KEY_CREEPKILLS,
+		KEY_CREEPDENIES,
+		KEY_ASSISTS,
+		KEY_GOLD,
+		KEY_NEUTRALKILLS,
+		KEY_ITEM1,
+		KEY_ITEM2,
+		KEY_ITEM3,
+		KEY_ITEM4,
+		KEY_ITEM5,
+		KEY_ITEM6,
+		KEY_HEROID,
+		KEY_ID
+	};
+
+private:
+	CDBDotAPlayer *m_Players[12];
+	uint32_t m_Winner;
+	uint32_t m_Min;
+	uint32_t m_Sec;
+	uint32_t m_GameStart;
+
+	static uint32_t GetDataKey( const char *key, uint32_t length );
+	static uint32_t GetGlobalKey( const char *key, uint32_t length );
+	static uint32_t GetPlayerKey( const char *key, uint32_t length );
+
+	void ProcessData( const char *key, uint32_t keyLength, uint32_t value, CGHostDB *DB );
+	void ProcessGlobal( const char *key, uint32_t keyLength, uint32_t value );
+	void ProcessPlayer( uint32_t ID, const char *key, uint32_t keyLength, const unsigned char *value );
+
+public:
+	CStatsDOTA( CStatsGame *nGame );
+	virtual ~CStatsDOTA( );
+	
+	virtual void SetWinner(uint32_t winner) { m_Winner = winner; }
+
+	virtual bool ProcessAction( CIncomingAction *Action, CGHostDB *DB, CGHost *GHost );
+	virtual void Save( CGHost *GHost, vector<CDBGamePlayer *>& DBGamePlayers, CGHostDB *DB, uint32_t GameID );
+	
+};
+
+#endif